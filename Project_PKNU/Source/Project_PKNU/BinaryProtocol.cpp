@@ -0,0 +1,191 @@
+#include "BinaryProtocol.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+    // 속도는 성분마다 int16 (cm/s, deg/s). 범위 밖은 잘라냄
+    void WriteVelocity16(FArchive& Ar, const FVector& Velocity)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            int16 Value = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Velocity[Axis]), (int32)MIN_int16, (int32)MAX_int16));
+            Ar << Value;
+        }
+    }
+
+    void ReadVelocity16(FArchive& Ar, FVector& OutVelocity)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            int16 Value = 0;
+            Ar << Value;
+            OutVelocity[Axis] = Value;
+        }
+    }
+}
+
+void FPknuBinaryProtocol::EncodeDelta(TArray<uint8>& Out, EPknuBinaryMessage Kind, const FPknuDeltaFrame& In, const FTransformQuantizer& Quantizer)
+{
+    Out.Reset();
+    FMemoryWriter Ar(Out);
+
+    uint8 KindByte = static_cast<uint8>(Kind);
+    Ar << KindByte;
+    uint32 WireHandle = In.WireHandle;
+    Ar << WireHandle;
+
+    uint16 Seq = In.Seq;
+    uint16 Baseline = In.Baseline;
+    uint8 FieldMask = In.FieldMask;
+    Ar << Seq << Baseline << FieldMask;
+
+    // 달라진 필드만 비트 패킹
+    {
+        FQuantizedBitWriter Bits(Out);
+        const FQuantizedTransform& T = In.State.Transform;
+        if (FieldMask & EDeltaField::X) Bits.Write(T.X, Quantizer.PositionBits);
+        if (FieldMask & EDeltaField::Y) Bits.Write(T.Y, Quantizer.PositionBits);
+        if (FieldMask & EDeltaField::Z) Bits.Write(T.Z, Quantizer.PositionBits);
+        if (FieldMask & EDeltaField::Rotation) Bits.Write(T.Rotation, 2 + 3 * Quantizer.RotationBits);
+        if (FieldMask & EDeltaField::Speed) Bits.Write(In.State.Speed, 16);
+        if (FieldMask & EDeltaField::Falling) Bits.Write(In.State.bIsFalling ? 1 : 0, 1);
+        Bits.Flush();
+    }
+    Ar.Seek(Out.Num());
+
+    if (Kind == EPknuBinaryMessage::Transform)
+    {
+        double Timestamp = In.Timestamp;
+        Ar << Timestamp;
+    }
+    else if (Kind == EPknuBinaryMessage::WorldTransform)
+    {
+        WriteVelocity16(Ar, In.LinearVelocity);
+        WriteVelocity16(Ar, In.AngularVelocity);
+        uint8 Flags = In.bClaim ? 1 : 0;
+        Ar << Flags;
+    }
+}
+
+bool FPknuBinaryProtocol::DecodeAck(const uint8* Data, int32 Size, TArray<FPknuAckEntry>& OutEntries)
+{
+    EPknuBinaryMessage Kind;
+    if (!PeekKind(Data, Size, Kind) || Kind != EPknuBinaryMessage::Ack) return false;
+
+    FMemoryReaderView Ar(MakeArrayView(Data, Size));
+    Ar.Seek(1);
+
+    uint8 Count = 0;
+    Ar << Count;
+
+    OutEntries.Reset();
+    for (int32 i = 0; i < Count && !Ar.IsError(); ++i)
+    {
+        FPknuAckEntry& Entry = OutEntries.AddDefaulted_GetRef();
+        Ar << Entry.WireHandle << Entry.Seq;
+    }
+
+    return !Ar.IsError();
+}
+
+namespace
+{
+    // Handle 뒤에 붙는 양자화 transform 을 읽어 Out 을 채움
+    bool ReadPackedTransform(FMemoryReaderView& Ar, const uint8* Data, int32 Size, const FTransformQuantizer& Quantizer, FPknuBinaryTransform& Out)
+    {
+        if (Ar.IsError() || !Quantizer.Unpack(Data + Ar.Tell(), Size - (int32)Ar.Tell(), Out.Quantized)) return false;
+        Ar.Seek(Ar.Tell() + Quantizer.GetPackedBytes());
+        Out.Location = Quantizer.DequantizeLocation(Out.Quantized);
+        Out.Rotation = Quantizer.DequantizeRotation(Out.Quantized).Rotator();
+        return true;
+    }
+}
+
+bool FPknuBinaryProtocol::DecodeUpdateBatch(const uint8* Data, int32 Size, const FTransformQuantizer& Quantizer, TArray<FPknuBinaryTransform>& OutPlayers, TArray<FPknuBinaryTransform>& OutObjects)
+{
+    EPknuBinaryMessage Kind;
+    if (!PeekKind(Data, Size, Kind) || Kind != EPknuBinaryMessage::UpdateBatch) return false;
+
+    FMemoryReaderView Ar(MakeArrayView(Data, Size));
+    Ar.Seek(1);
+
+    OutPlayers.Reset();
+    OutObjects.Reset();
+
+    double ServerTime = 0.0;
+    uint16 PlayerCount = 0;
+    Ar << ServerTime << PlayerCount;
+    for (int32 i = 0; i < PlayerCount && !Ar.IsError(); ++i)
+    {
+        FPknuBinaryTransform& Player = OutPlayers.AddDefaulted_GetRef();
+        Ar << Player.WireHandle;
+        if (!ReadPackedTransform(Ar, Data, Size, Quantizer, Player)) return false;
+
+        uint16 Speed = 0;
+        uint8 Flags = 0;
+        uint16 AgeMs = 0;
+        Ar << Speed << Flags << AgeMs;
+        Player.Speed = Speed;
+        Player.bIsFalling = (Flags & 1) != 0;
+        Player.Timestamp = ServerTime - AgeMs;
+    }
+
+    uint16 ObjectCount = 0;
+    Ar << ObjectCount;
+    for (int32 i = 0; i < ObjectCount && !Ar.IsError(); ++i)
+    {
+        FPknuBinaryTransform& Object = OutObjects.AddDefaulted_GetRef();
+        Ar << Object.WireHandle << Object.SourceHandle;
+        if (!ReadPackedTransform(Ar, Data, Size, Quantizer, Object)) return false;
+        ReadVelocity16(Ar, Object.LinearVelocity);
+        ReadVelocity16(Ar, Object.AngularVelocity);
+    }
+
+    return !Ar.IsError();
+}
+
+bool FPknuBinaryProtocol::DecodeStateChunk(const uint8* Data, int32 Size, FPknuStateChunkHeader& OutHeader, TArray<uint8>& OutJsonUtf8)
+{
+    EPknuBinaryMessage Kind;
+    if (!PeekKind(Data, Size, Kind) || Kind != EPknuBinaryMessage::StateChunk) return false;
+
+    FMemoryReaderView Ar(MakeArrayView(Data, Size));
+    Ar.Seek(1);
+    Ar << OutHeader.SyncId << OutHeader.Chunk << OutHeader.ChunkCount << OutHeader.RawSize;
+    if (Ar.IsError() || OutHeader.Chunk >= OutHeader.ChunkCount || OutHeader.RawSize > MaxStateChunkRawSize) return false;
+
+    const int32 HeaderSize = static_cast<int32>(Ar.Tell());
+    OutJsonUtf8.SetNumUninitialized(OutHeader.RawSize, EAllowShrinking::No);
+    return FCompression::UncompressMemory(NAME_Zlib, OutJsonUtf8.GetData(), OutHeader.RawSize, Data + HeaderSize, Size - HeaderSize);
+}
+
+void FPknuBinaryProtocol::BeginBatch(TArray<uint8>& Batch)
+{
+    Batch.Reset();
+    Batch.Add(static_cast<uint8>(EPknuBinaryMessage::Batch));
+    Batch.Add(0); // Count 는 FinishBatch 에서 기록
+}
+
+void FPknuBinaryProtocol::AppendToBatch(TArray<uint8>& Batch, const TArray<uint8>& Frame)
+{
+    check(Frame.Num() <= MAX_uint16);
+    const uint16 Length = static_cast<uint16>(Frame.Num());
+    Batch.Add(static_cast<uint8>(Length & 0xFF));
+    Batch.Add(static_cast<uint8>(Length >> 8));
+    Batch.Append(Frame);
+}
+
+void FPknuBinaryProtocol::FinishBatch(TArray<uint8>& Batch, int32 Count)
+{
+    check(Batch.Num() >= 2 && Count <= MaxBatchCount);
+    Batch[1] = static_cast<uint8>(Count);
+}
+
+bool FPknuBinaryProtocol::PeekKind(const uint8* Data, int32 Size, EPknuBinaryMessage& OutKind)
+{
+    if (!Data || Size < 2) return false;
+    OutKind = static_cast<EPknuBinaryMessage>(Data[0]);
+    return OutKind >= EPknuBinaryMessage::Transform && OutKind <= EPknuBinaryMessage::StateChunk;
+}
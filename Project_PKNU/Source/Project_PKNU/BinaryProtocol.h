@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TransformQuantization.h"
+#include "DeltaCompression.h"
+
+// 바이너리 프레임의 첫 바이트 (메시지 종류)
+// server/protocol.js 의 MSG 와 값이 같아야 함
+enum class EPknuBinaryMessage : uint8
+{
+    Transform = 1,       // 클라이언트 -> 서버 : 플레이어 transform (델타)
+    // 2, 3 : 엔티티별 전체 상태 프레임 (UpdateBatch 로 대체, 재사용하지 않음)
+    WorldTransform = 4,  // 클라이언트 -> 서버 : 월드 오브젝트 transform (델타)
+    Ack = 5,             // 서버 -> 클라이언트 : 델타 프레임 수신 확인
+    Batch = 6,           // 클라이언트 -> 서버 : 한 네트워크 틱에 만든 프레임 묶음
+    UpdateBatch = 7,     // 서버 -> 클라이언트 : 서버 틱 하나의 플레이어 / 월드 오브젝트 스냅샷 (render_update / update_batch)
+    StateChunk = 8,      // 서버 -> 클라이언트 : zlib 압축된 초기 상태(state_sync) 청크
+};
+
+// UpdateBatch 의 플레이어 / 오브젝트 항목 하나를 디코딩한 결과
+// (SpawnOrUpdateRemoteCharacter / SpawnOrUpdateWorldObject 인자와 1:1 대응)
+struct FPknuBinaryTransform
+{
+    uint32 WireHandle = 0; // 서버가 할당한 엔티티 핸들 (handle_map 으로 이름과 연결)
+    uint32 SourceHandle = 0; // UpdateBatch 오브젝트 : 시뮬레이션 소유자(마지막으로 바꾼 플레이어)의 핸들
+    FVector Location = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    FQuantizedTransform Quantized; // 와이어의 양자화 값 그대로 (스냅샷 버퍼에 그대로 사용 가능)
+    float Speed = 0.f;
+    bool bIsFalling = false;
+    double Timestamp = 0.0; // 송신 시각, 서버 시계 기준 ms (플레이어에만 포함)
+    FVector LinearVelocity = FVector::ZeroVector;  // UpdateBatch 오브젝트 : cm/s
+    FVector AngularVelocity = FVector::ZeroVector; // UpdateBatch 오브젝트 : deg/s (월드 축)
+};
+
+// 송신할 델타 프레임 하나
+struct FPknuDeltaFrame
+{
+    uint32 WireHandle = 0;
+    FDeltaEntityState State;
+    uint16 Seq = 0;
+    uint16 Baseline = FDeltaSendChannel::KeyframeBaseline;
+    uint8 FieldMask = EDeltaField::All;
+    double Timestamp = 0.0; // Transform 에만 포함
+    // WorldTransform 에만 포함
+    FVector LinearVelocity = FVector::ZeroVector;  // cm/s
+    FVector AngularVelocity = FVector::ZeroVector; // deg/s (월드 축)
+    bool bClaim = false; // 직접 밀어서 다른 클라이언트의 시뮬레이션 소유권을 넘겨받으려 함
+};
+
+struct FPknuAckEntry
+{
+    uint32 WireHandle = 0;
+    uint16 Seq = 0;
+};
+
+struct FPknuStateChunkHeader
+{
+    uint16 SyncId = 0;     // request_state 마다 바뀜 (이전 동기화의 청크와 구분)
+    uint16 Chunk = 0;
+    uint16 ChunkCount = 0;
+    uint32 RawSize = 0;    // 압축 해제 후 JSON 바이트 수
+};
+
+/**
+ * transform / update 송신과 render_update / update_batch 수신용 바이너리 와이어 포맷.
+ * 접속 시 hello / hello_ack 로 Version 이 일치할 때만 사용하고, 그 외에는 JSON 으로 폴백한다.
+ *
+ * 레이아웃 (little-endian, Handle 은 서버가 할당한 uint32 엔티티 핸들 - EntityHandleTable.h):
+ *   Transform / WorldTransform (클라이언트 -> 서버, ack 된 baseline 대비 델타)
+ *     uint8 Kind, uint32 Handle, uint16 Seq, uint16 Baseline (0xFFFF = 키프레임), uint8 FieldMask
+ *     FieldMask 에 켜진 필드만 LSB-first 비트 패킹 (X/Y/Z: PositionBits, Rotation: 2 + 3 x RotationBits,
+ *     Speed: 16, Falling: 1), 바이트 경계 패딩
+ *     [Transform] double Timestamp
+ *     [WorldTransform] 3 x int16 LinearVelocity (cm/s), 3 x int16 AngularVelocity (deg/s), uint8 Flags (bit0 = claim)
+ *   Ack
+ *     uint8 Kind, uint8 Count, Count x (uint32 Handle, uint16 Seq)
+ *   Batch
+ *     uint8 Kind, uint8 Count, Count x (uint16 Length, Length 바이트의 Transform / WorldTransform 프레임)
+ *   UpdateBatch (서버 -> 클라이언트, 서버 틱마다 한 번)
+ *     uint8 Kind, double ServerTime (서버 시계 ms), uint16 PlayerCount,
+ *     PlayerCount x (uint32 Handle, Pack 결과, uint16 Speed, uint8 Flags, uint16 AgeMs)
+ *     AgeMs = ServerTime - 플레이어가 보낸 ts (송신 시각 = ServerTime - AgeMs)
+ *     uint16 ObjectCount, ObjectCount x (uint32 Handle, uint32 SourceHandle, Pack 결과,
+ *                                        3 x int16 LinearVelocity (cm/s), 3 x int16 AngularVelocity (deg/s))
+ *     SourceHandle = 오브젝트의 시뮬레이션 소유자 (서버는 소유자가 보낸 WorldTransform 만 받음)
+ *   StateChunk (서버 -> 클라이언트, hello 에 stateChunks 를 보냈을 때만)
+ *     uint8 Kind, uint16 SyncId, uint16 Chunk, uint16 ChunkCount, uint32 RawSize,
+ *     zlib 으로 압축한 UTF-8 JSON (state_sync 와 같은 형태, 엔티티 일부만 포함)
+ *     적용 후 { type: "state_chunk_ack", syncId, chunk } 로 응답하면 서버가 다음 청크를 보냄
+ */
+struct PROJECT_PKNU_API FPknuBinaryProtocol
+{
+    static constexpr int32 Version = 8;
+    static constexpr int32 MaxBatchCount = 255;
+    static constexpr uint32 MaxStateChunkRawSize = 16 * 1024 * 1024;
+
+    // Out 은 Reset 후 다시 채워짐 (호출자가 버퍼를 재사용)
+    static void EncodeDelta(TArray<uint8>& Out, EPknuBinaryMessage Kind, const FPknuDeltaFrame& In, const FTransformQuantizer& Quantizer);
+
+    static bool DecodeAck(const uint8* Data, int32 Size, TArray<FPknuAckEntry>& OutEntries);
+
+    // OutPlayers / OutObjects 는 Reset 후 다시 채워짐
+    static bool DecodeUpdateBatch(const uint8* Data, int32 Size, const FTransformQuantizer& Quantizer, TArray<FPknuBinaryTransform>& OutPlayers, TArray<FPknuBinaryTransform>& OutObjects);
+
+    // OutJsonUtf8 은 압축 해제된 JSON (널 종료 없음)
+    static bool DecodeStateChunk(const uint8* Data, int32 Size, FPknuStateChunkHeader& OutHeader, TArray<uint8>& OutJsonUtf8);
+
+    // Batch 프레임 조립: BeginBatch 후 AppendToBatch 를 반복하고 FinishBatch 로 개수를 기록
+    static void BeginBatch(TArray<uint8>& Batch);
+    static void AppendToBatch(TArray<uint8>& Batch, const TArray<uint8>& Frame);
+    static void FinishBatch(TArray<uint8>& Batch, int32 Count);
+
+    // 첫 바이트만 확인
+    static bool PeekKind(const uint8* Data, int32 Size, EPknuBinaryMessage& OutKind);
+};
@@ -0,0 +1,358 @@
+#include "BinaryProtocol.h"
+#include "EntityHandleTable.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * server/protocol.js 와의 와이어 호환성 확인.
+ * 골든 벡터(server/protocol_vectors.json)는 서버의 node protocol_test.js 와 공유하므로,
+ * 한쪽 포맷만 바뀌면 양쪽 중 하나가 실패한다.
+ */
+namespace
+{
+    // 버전이 다르거나 파일을 읽지 못하면 Test 에 오류를 남기고 nullptr
+    TSharedPtr<FJsonObject> LoadVectors(FAutomationTestBase& Test)
+    {
+        const FString Path = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectDir(), TEXT("../server/protocol_vectors.json")));
+
+        FString Text;
+        TSharedPtr<FJsonObject> Vectors;
+        if (!FFileHelper::LoadFileToString(Text, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Vectors) || !Vectors.IsValid())
+        {
+            Test.AddError(FString::Printf(TEXT("골든 벡터를 읽지 못함: %s"), *Path));
+            return nullptr;
+        }
+        if ((int32)Vectors->GetNumberField(TEXT("version")) != FPknuBinaryProtocol::Version)
+        {
+            Test.AddError(TEXT("골든 벡터의 version 이 FPknuBinaryProtocol::Version 과 다름"));
+            return nullptr;
+        }
+        return Vectors;
+    }
+
+    FTransformQuantizer ReadQuantizer(const TSharedPtr<FJsonObject>& Vectors)
+    {
+        const TSharedPtr<FJsonObject>& QuantObj = Vectors->GetObjectField(TEXT("quantizer"));
+        const TArray<TSharedPtr<FJsonValue>>& MinArr = QuantObj->GetArrayField(TEXT("min"));
+        const TArray<TSharedPtr<FJsonValue>>& MaxArr = QuantObj->GetArrayField(TEXT("max"));
+        return FTransformQuantizer(
+            FBox(FVector(MinArr[0]->AsNumber(), MinArr[1]->AsNumber(), MinArr[2]->AsNumber()),
+                FVector(MaxArr[0]->AsNumber(), MaxArr[1]->AsNumber(), MaxArr[2]->AsNumber())),
+            (int32)QuantObj->GetNumberField(TEXT("positionBits")), (int32)QuantObj->GetNumberField(TEXT("rotationBits")));
+    }
+
+    FVector ReadVector(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Field)
+    {
+        const TSharedPtr<FJsonObject>& V = Obj->GetObjectField(Field);
+        return FVector(V->GetNumberField(TEXT("x")), V->GetNumberField(TEXT("y")), V->GetNumberField(TEXT("z")));
+    }
+
+    FQuat ReadRotation(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Field)
+    {
+        const TSharedPtr<FJsonObject>& R = Obj->GetObjectField(Field);
+        return FRotator(R->GetNumberField(TEXT("pitch")), R->GetNumberField(TEXT("yaw")), R->GetNumberField(TEXT("roll"))).Quaternion();
+    }
+
+    // { x, y, z, largest, rest } (protocol.js Quantizer.quantize 결과) -> FQuantizedTransform
+    FQuantizedTransform ReadQuantized(const TSharedPtr<FJsonObject>& Obj, const FTransformQuantizer& Quantizer)
+    {
+        FQuantizedTransform Out;
+        Out.X = (uint32)Obj->GetNumberField(TEXT("x"));
+        Out.Y = (uint32)Obj->GetNumberField(TEXT("y"));
+        Out.Z = (uint32)Obj->GetNumberField(TEXT("z"));
+        Out.Rotation = (uint32)Obj->GetNumberField(TEXT("largest"));
+        const TArray<TSharedPtr<FJsonValue>>& Rest = Obj->GetArrayField(TEXT("rest"));
+        for (int32 i = 0; i < Rest.Num(); ++i)
+        {
+            Out.Rotation |= (uint32)Rest[i]->AsNumber() << (2 + i * Quantizer.RotationBits);
+        }
+        return Out;
+    }
+
+    FString ToHex(const TArray<uint8>& Bytes)
+    {
+        return BytesToHex(Bytes.GetData(), Bytes.Num()).ToLower();
+    }
+
+    TArray<uint8> ReadHex(const TSharedPtr<FJsonObject>& Obj)
+    {
+        const FString Hex = Obj->GetStringField(TEXT("hex"));
+        TArray<uint8> Bytes;
+        Bytes.SetNumUninitialized(Hex.Len() / 2);
+        HexToBytes(Hex, Bytes.GetData());
+        return Bytes;
+    }
+
+    // deltas 항목 하나를 클라이언트 인코더로 인코딩
+    void EncodeDeltaVector(const TSharedPtr<FJsonObject>& V, const FTransformQuantizer& Quantizer, TArray<uint8>& Out)
+    {
+        const TSharedPtr<FJsonObject>& State = V->GetObjectField(TEXT("state"));
+        const EPknuBinaryMessage Kind = V->GetStringField(TEXT("kind")) == TEXT("TRANSFORM") ? EPknuBinaryMessage::Transform : EPknuBinaryMessage::WorldTransform;
+
+        FPknuDeltaFrame Frame;
+        Frame.WireHandle = (uint32)V->GetNumberField(TEXT("h"));
+        Frame.Seq = (uint16)V->GetNumberField(TEXT("seq"));
+        Frame.Baseline = (uint16)V->GetNumberField(TEXT("baseline"));
+        Frame.FieldMask = (uint8)V->GetNumberField(TEXT("mask"));
+        Frame.State.Transform = ReadQuantized(State, Quantizer);
+        Frame.State.Speed = (uint16)State->GetNumberField(TEXT("speed"));
+        Frame.State.bIsFalling = State->GetBoolField(TEXT("isFalling"));
+        if (Kind == EPknuBinaryMessage::Transform)
+        {
+            Frame.Timestamp = V->GetNumberField(TEXT("ts"));
+        }
+        else
+        {
+            const TSharedPtr<FJsonObject>& World = V->GetObjectField(TEXT("world"));
+            Frame.LinearVelocity = ReadVector(World, TEXT("velocity"));
+            Frame.AngularVelocity = ReadVector(World, TEXT("angularVelocity"));
+            Frame.bClaim = World->GetBoolField(TEXT("claim"));
+        }
+
+        FPknuBinaryProtocol::EncodeDelta(Out, Kind, Frame, Quantizer);
+    }
+
+    // WriteVelocity16 / protocol.js writeVector16 과 같은 규칙
+    FVector Clamp16(const FVector& V)
+    {
+        return FVector(
+            FMath::Clamp(FMath::RoundToInt(V.X), (int32)MIN_int16, (int32)MAX_int16),
+            FMath::Clamp(FMath::RoundToInt(V.Y), (int32)MIN_int16, (int32)MAX_int16),
+            FMath::Clamp(FMath::RoundToInt(V.Z), (int32)MIN_int16, (int32)MAX_int16));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuBinaryProtocolQuantizationTest, "Project_PKNU.Network.BinaryProtocol.Quantization",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuBinaryProtocolQuantizationTest::RunTest(const FString& Parameters)
+{
+    const TSharedPtr<FJsonObject> Vectors = LoadVectors(*this);
+    if (!Vectors) return false;
+    const FTransformQuantizer Quantizer = ReadQuantizer(Vectors);
+
+    for (const TSharedPtr<FJsonValue>& Value : Vectors->GetArrayField(TEXT("quantize")))
+    {
+        const TSharedPtr<FJsonObject>& V = Value->AsObject();
+        const FString Name = V->GetStringField(TEXT("name"));
+
+        const FQuantizedTransform Expected = ReadQuantized(V->GetObjectField(TEXT("expect")), Quantizer);
+        const FQuantizedTransform Quantized = Quantizer.Quantize(ReadVector(V, TEXT("position")), ReadRotation(V, TEXT("rotation")));
+        TestTrue(Name + TEXT(": Quantize"), Quantized == Expected);
+
+        TArray<uint8> Packed;
+        Quantizer.Pack(Packed, Expected);
+        TestEqual(Name + TEXT(": Pack"), ToHex(Packed), V->GetStringField(TEXT("hex")));
+
+        FQuantizedTransform Unpacked;
+        TestTrue(Name + TEXT(": Unpack"), Quantizer.Unpack(Packed.GetData(), Packed.Num(), Unpacked) && Unpacked == Expected);
+    }
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuBinaryProtocolDeltaTest, "Project_PKNU.Network.BinaryProtocol.DeltaFrames",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuBinaryProtocolDeltaTest::RunTest(const FString& Parameters)
+{
+    const TSharedPtr<FJsonObject> Vectors = LoadVectors(*this);
+    if (!Vectors) return false;
+    const FTransformQuantizer Quantizer = ReadQuantizer(Vectors);
+
+    // seq / baseline / 필드 마스크, Transform 의 ts, WorldTransform 의 int16 속도와 claim
+    TArray<uint8> Encoded;
+    for (const TSharedPtr<FJsonValue>& Value : Vectors->GetArrayField(TEXT("deltas")))
+    {
+        const TSharedPtr<FJsonObject>& V = Value->AsObject();
+        EncodeDeltaVector(V, Quantizer, Encoded);
+        TestEqual(V->GetStringField(TEXT("name")) + TEXT(": EncodeDelta"), ToHex(Encoded), V->GetStringField(TEXT("hex")));
+    }
+
+    const TSharedPtr<FJsonObject>& AckVector = Vectors->GetObjectField(TEXT("ack"));
+    const TArray<uint8> AckBytes = ReadHex(AckVector);
+    const TArray<TSharedPtr<FJsonValue>>& Entries = AckVector->GetArrayField(TEXT("entries"));
+
+    TArray<FPknuAckEntry> Decoded;
+    if (TestTrue(TEXT("ack: DecodeAck"), FPknuBinaryProtocol::DecodeAck(AckBytes.GetData(), AckBytes.Num(), Decoded)) &&
+        TestEqual(TEXT("ack: count"), Decoded.Num(), Entries.Num()))
+    {
+        for (int32 i = 0; i < Entries.Num(); ++i)
+        {
+            TestEqual(TEXT("ack: handle"), (int64)Decoded[i].WireHandle, (int64)Entries[i]->AsObject()->GetNumberField(TEXT("h")));
+            TestEqual(TEXT("ack: seq"), (int32)Decoded[i].Seq, (int32)Entries[i]->AsObject()->GetNumberField(TEXT("seq")));
+        }
+    }
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuEntityHandleWireTest, "Project_PKNU.Network.EntityHandles",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuEntityHandleWireTest::RunTest(const FString& Parameters)
+{
+    const TSharedPtr<FJsonObject> Vectors = LoadVectors(*this);
+    if (!Vectors) return false;
+
+    // server/handles.js 가 할당한 순서대로 handle_map 을 받았을 때와 같은 BindWire / UnbindWire 호출
+    FPknuEntityHandleTable Table;
+    TMap<FString, uint32> Live;
+    TArray<uint32> Released;
+    for (const TSharedPtr<FJsonValue>& Value : Vectors->GetArrayField(TEXT("handles")))
+    {
+        const TSharedPtr<FJsonObject>& Step = Value->AsObject();
+        const FString Name = Step->GetStringField(TEXT("name"));
+
+        if (Step->GetStringField(TEXT("op")) == TEXT("allocate"))
+        {
+            const uint32 Wire = (uint32)Step->GetNumberField(TEXT("h"));
+            const TSharedPtr<FJsonObject>& Slot = Step->GetObjectField(TEXT("slot"));
+            TestEqual(Name + TEXT(": index"), (int64)FPknuEntityHandle(Wire).GetIndex(), (int64)Slot->GetNumberField(TEXT("index")));
+            TestEqual(Name + TEXT(": generation"), (int64)FPknuEntityHandle(Wire).GetGeneration(), (int64)Slot->GetNumberField(TEXT("generation")));
+
+            const FPknuEntityHandle Local = Table.BindWire(Wire, Name);
+            TestTrue(Name + TEXT(": FindByWire"), Table.FindByWire(Wire) == Local);
+            TestEqual(Name + TEXT(": GetWireHandle"), (int64)Table.GetWireHandle(Local), (int64)Wire);
+            Live.Add(Name, Wire);
+        }
+        else
+        {
+            const uint32 Wire = Live.FindAndRemoveChecked(Name);
+            Table.UnbindWire(Wire);
+            TestFalse(Name + TEXT(": 반납된 핸들이 매칭됨"), Table.FindByWire(Wire).IsValid());
+            Released.Add(Wire);
+        }
+    }
+
+    // 슬롯이 다른 세대로 재사용된 뒤에도 이전 세대 핸들은 새 엔티티와 매칭되지 않아야 함
+    for (const uint32 Wire : Released)
+    {
+        TestFalse(FString::Printf(TEXT("이전 세대 핸들 %u 이 매칭됨"), Wire), Table.FindByWire(Wire).IsValid());
+    }
+    for (const TPair<FString, uint32>& Pair : Live)
+    {
+        TestTrue(Pair.Key + TEXT(": 살아 있는 핸들"), Table.FindByWire(Pair.Value) == Table.Find(Pair.Key));
+    }
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuBinaryProtocolBatchTest, "Project_PKNU.Network.BinaryProtocol.Batch",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuBinaryProtocolBatchTest::RunTest(const FString& Parameters)
+{
+    const TSharedPtr<FJsonObject> Vectors = LoadVectors(*this);
+    if (!Vectors) return false;
+    const FTransformQuantizer Quantizer = ReadQuantizer(Vectors);
+
+    const TSharedPtr<FJsonObject>& V = Vectors->GetObjectField(TEXT("batch"));
+    const TArray<TSharedPtr<FJsonValue>>& Names = V->GetArrayField(TEXT("frames"));
+
+    TArray<uint8> Batch, Frame;
+    FPknuBinaryProtocol::BeginBatch(Batch);
+    for (const TSharedPtr<FJsonValue>& FrameName : Names)
+    {
+        for (const TSharedPtr<FJsonValue>& Delta : Vectors->GetArrayField(TEXT("deltas")))
+        {
+            if (Delta->AsObject()->GetStringField(TEXT("name")) == FrameName->AsString())
+            {
+                EncodeDeltaVector(Delta->AsObject(), Quantizer, Frame);
+                FPknuBinaryProtocol::AppendToBatch(Batch, Frame);
+            }
+        }
+    }
+    FPknuBinaryProtocol::FinishBatch(Batch, Names.Num());
+    TestEqual(TEXT("batch"), ToHex(Batch), V->GetStringField(TEXT("hex")));
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuBinaryProtocolUpdateBatchTest, "Project_PKNU.Network.BinaryProtocol.UpdateBatch",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuBinaryProtocolUpdateBatchTest::RunTest(const FString& Parameters)
+{
+    const TSharedPtr<FJsonObject> Vectors = LoadVectors(*this);
+    if (!Vectors) return false;
+    const FTransformQuantizer Quantizer = ReadQuantizer(Vectors);
+
+    const TSharedPtr<FJsonObject>& V = Vectors->GetObjectField(TEXT("updateBatch"));
+    const TArray<uint8> Bytes = ReadHex(V);
+    const double ServerTime = V->GetNumberField(TEXT("serverTime"));
+    const TArray<TSharedPtr<FJsonValue>>& Players = V->GetArrayField(TEXT("players"));
+    const TArray<TSharedPtr<FJsonValue>>& Objects = V->GetArrayField(TEXT("objects"));
+
+    TArray<FPknuBinaryTransform> DecodedPlayers, DecodedObjects;
+    if (!TestTrue(TEXT("DecodeUpdateBatch"), FPknuBinaryProtocol::DecodeUpdateBatch(Bytes.GetData(), Bytes.Num(), Quantizer, DecodedPlayers, DecodedObjects)) ||
+        !TestEqual(TEXT("player count"), DecodedPlayers.Num(), Players.Num()) ||
+        !TestEqual(TEXT("object count"), DecodedObjects.Num(), Objects.Num()))
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < Players.Num(); ++i)
+    {
+        const TSharedPtr<FJsonObject>& P = Players[i]->AsObject();
+        const TSharedPtr<FJsonObject>& State = P->GetObjectField(TEXT("state"));
+        const FPknuBinaryTransform& Decoded = DecodedPlayers[i];
+
+        TestEqual(TEXT("player handle"), (int64)Decoded.WireHandle, (int64)P->GetNumberField(TEXT("h")));
+        TestTrue(TEXT("player transform"),
+            Decoded.Quantized == Quantizer.Quantize(ReadVector(State, TEXT("position")), ReadRotation(State, TEXT("rotation"))));
+        TestEqual(TEXT("player speed"), Decoded.Speed, (float)FMath::RoundToInt(State->GetNumberField(TEXT("speed"))));
+        TestEqual(TEXT("player isFalling"), Decoded.bIsFalling, State->GetBoolField(TEXT("isFalling")));
+        // ageMs 는 정수 ms 로 전송
+        TestEqual(TEXT("player timestamp"), Decoded.Timestamp, ServerTime - FMath::RoundToDouble(ServerTime - State->GetNumberField(TEXT("ts"))));
+    }
+
+    for (int32 i = 0; i < Objects.Num(); ++i)
+    {
+        const TSharedPtr<FJsonObject>& O = Objects[i]->AsObject();
+        const TSharedPtr<FJsonObject>& State = O->GetObjectField(TEXT("state"));
+        const FPknuBinaryTransform& Decoded = DecodedObjects[i];
+
+        TestEqual(TEXT("object handle"), (int64)Decoded.WireHandle, (int64)O->GetNumberField(TEXT("h")));
+        TestEqual(TEXT("object src"), (int64)Decoded.SourceHandle, (int64)O->GetNumberField(TEXT("src")));
+        TestTrue(TEXT("object transform"),
+            Decoded.Quantized == Quantizer.Quantize(ReadVector(State, TEXT("position")), ReadRotation(State, TEXT("rotation"))));
+        TestEqual(TEXT("object velocity"), Decoded.LinearVelocity, Clamp16(ReadVector(State, TEXT("velocity"))));
+        TestEqual(TEXT("object angularVelocity"), Decoded.AngularVelocity, Clamp16(ReadVector(State, TEXT("angularVelocity"))));
+    }
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuBinaryProtocolStateChunkTest, "Project_PKNU.Network.BinaryProtocol.StateChunk",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuBinaryProtocolStateChunkTest::RunTest(const FString& Parameters)
+{
+    const TSharedPtr<FJsonObject> Vectors = LoadVectors(*this);
+    if (!Vectors) return false;
+
+    const TSharedPtr<FJsonObject>& V = Vectors->GetObjectField(TEXT("stateChunk"));
+    const TSharedPtr<FJsonObject>& Expected = V->GetObjectField(TEXT("state"));
+    const TArray<uint8> Bytes = ReadHex(V);
+
+    FPknuStateChunkHeader Header;
+    TArray<uint8> JsonUtf8;
+    if (!TestTrue(TEXT("DecodeStateChunk"), FPknuBinaryProtocol::DecodeStateChunk(Bytes.GetData(), Bytes.Num(), Header, JsonUtf8))) return false;
+
+    TestEqual(TEXT("syncId"), (int32)Header.SyncId, (int32)V->GetNumberField(TEXT("syncId")));
+    TestEqual(TEXT("chunk"), (int32)Header.Chunk, (int32)V->GetNumberField(TEXT("chunk")));
+    TestEqual(TEXT("chunkCount"), (int32)Header.ChunkCount, (int32)V->GetNumberField(TEXT("chunkCount")));
+    TestEqual(TEXT("rawSize"), (int32)Header.RawSize, JsonUtf8.Num());
+
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(JsonUtf8.GetData()), JsonUtf8.Num());
+    TSharedPtr<FJsonObject> State;
+    if (TestTrue(TEXT("JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get())), State) && State.IsValid()))
+    {
+        TestEqual(TEXT("type"), State->GetStringField(TEXT("type")), Expected->GetStringField(TEXT("type")));
+        TestEqual(TEXT("objects"), State->GetArrayField(TEXT("objects")).Num(), Expected->GetArrayField(TEXT("objects")).Num());
+    }
+    return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "DeltaCompression.h"
+
+void FDeltaSendChannel::Prepare(const FDeltaEntityState& State, int32 KeyframeInterval, uint16& OutSeq, uint16& OutBaseline, uint8& OutMask)
+{
+    OutSeq = NextSeq;
+    // 0xFFFF 는 키프레임 표시용으로 예약
+    NextSeq = (NextSeq + 1 == KeyframeBaseline) ? 0 : NextSeq + 1;
+
+    const FHistoryEntry* Baseline = (AckedSeq != INDEX_NONE) ? FindHistory((uint16)AckedSeq) : nullptr;
+    const bool bKeyframe = !Baseline || SentSinceKeyframe >= KeyframeInterval;
+
+    if (bKeyframe)
+    {
+        OutBaseline = KeyframeBaseline;
+        OutMask = EDeltaField::All;
+        SentSinceKeyframe = 0;
+    }
+    else
+    {
+        OutBaseline = Baseline->Seq;
+        OutMask = State.DiffMask(Baseline->State);
+        ++SentSinceKeyframe;
+    }
+
+    FHistoryEntry& Entry = History[OutSeq % HistorySize];
+    Entry.State = State;
+    Entry.Seq = OutSeq;
+    Entry.bValid = true;
+}
+
+void FDeltaSendChannel::Acknowledge(uint16 Seq)
+{
+    // 기록에 남아 있는 seq 만 baseline 으로 사용 가능
+    if (!FindHistory(Seq)) return;
+
+    // 순서가 뒤바뀐 오래된 ack 는 무시 (uint16 wrap-around 고려)
+    if (AckedSeq != INDEX_NONE && (int16)(Seq - (uint16)AckedSeq) <= 0) return;
+
+    AckedSeq = Seq;
+}
+
+void FDeltaSendChannel::Reset()
+{
+    for (FHistoryEntry& Entry : History)
+    {
+        Entry.bValid = false;
+    }
+    NextSeq = 0;
+    AckedSeq = INDEX_NONE;
+    SentSinceKeyframe = 0;
+}
+
+const FDeltaSendChannel::FHistoryEntry* FDeltaSendChannel::FindHistory(uint16 Seq) const
+{
+    const FHistoryEntry& Entry = History[Seq % HistorySize];
+    return (Entry.bValid && Entry.Seq == Seq) ? &Entry : nullptr;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TransformQuantization.h"
+
+// 델타 인코딩 대상 필드 (바이너리 프레임의 FieldMask 비트)
+namespace EDeltaField
+{
+    enum Type : uint8
+    {
+        X        = 1 << 0,
+        Y        = 1 << 1,
+        Z        = 1 << 2,
+        Rotation = 1 << 3,
+        Speed    = 1 << 4,
+        Falling  = 1 << 5,
+
+        All      = X | Y | Z | Rotation | Speed | Falling,
+    };
+}
+
+// 델타 비교 단위가 되는 엔티티 상태 (모두 양자화된 값이므로 정확히 비교 가능)
+struct FDeltaEntityState
+{
+    FQuantizedTransform Transform;
+    uint16 Speed = 0;
+    bool bIsFalling = false;
+
+    // Baseline 과 비교해 달라진 필드의 마스크
+    uint8 DiffMask(const FDeltaEntityState& Baseline) const
+    {
+        uint8 Mask = 0;
+        if (Transform.X != Baseline.Transform.X) Mask |= EDeltaField::X;
+        if (Transform.Y != Baseline.Transform.Y) Mask |= EDeltaField::Y;
+        if (Transform.Z != Baseline.Transform.Z) Mask |= EDeltaField::Z;
+        if (Transform.Rotation != Baseline.Transform.Rotation) Mask |= EDeltaField::Rotation;
+        if (Speed != Baseline.Speed) Mask |= EDeltaField::Speed;
+        if (bIsFalling != Baseline.bIsFalling) Mask |= EDeltaField::Falling;
+        return Mask;
+    }
+};
+
+/**
+ * 엔티티 하나의 송신 측 델타 채널.
+ * 보낸 상태를 seq 별로 기억해 두고, 서버가 ack 한 가장 최근 상태를 baseline 으로 달라진 필드만 보낸다.
+ * ack 가 없거나 baseline 이 기록에서 밀려났거나 KeyframeInterval 을 넘기면 전체 필드(키프레임)를 보낸다.
+ */
+class PROJECT_PKNU_API FDeltaSendChannel
+{
+public:
+    static constexpr uint16 KeyframeBaseline = 0xFFFF;
+    static constexpr int32 HistorySize = 32;
+
+    // 이번에 보낼 seq / baseline / 필드 마스크를 결정하고 State 를 기록에 남김
+    void Prepare(const FDeltaEntityState& State, int32 KeyframeInterval, uint16& OutSeq, uint16& OutBaseline, uint8& OutMask);
+
+    void Acknowledge(uint16 Seq);
+
+    void Reset();
+
+private:
+    struct FHistoryEntry
+    {
+        FDeltaEntityState State;
+        uint16 Seq = 0;
+        bool bValid = false;
+    };
+
+    const FHistoryEntry* FindHistory(uint16 Seq) const;
+
+    FHistoryEntry History[HistorySize];
+    uint16 NextSeq = 0;
+    int32 AckedSeq = INDEX_NONE; // 아직 ack 를 받지 못했으면 INDEX_NONE
+    int32 SentSinceKeyframe = 0;
+};
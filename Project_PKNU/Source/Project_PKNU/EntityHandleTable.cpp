@@ -0,0 +1,127 @@
+#include "EntityHandleTable.h"
+
+FPknuEntityHandle FPknuEntityHandleTable::Find(const FString& Name) const
+{
+    const FPknuEntityHandle* Handle = NameToHandle.Find(Name);
+    return Handle ? *Handle : FPknuEntityHandle();
+}
+
+FPknuEntityHandle FPknuEntityHandleTable::FindOrAdd(const FString& Name)
+{
+    if (const FPknuEntityHandle* Existing = NameToHandle.Find(Name))
+    {
+        return *Existing;
+    }
+
+    uint32 Index;
+    if (FreeIndices.Num() > 0)
+    {
+        Index = FreeIndices.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Index = Slots.Num();
+        check(Index <= FPknuEntityHandle::IndexMask);
+        Slots.AddDefaulted();
+    }
+
+    FSlot& Slot = Slots[Index];
+    // 세대 0 은 무효 핸들(0)과 겹치므로 건너뜀
+    Slot.Generation = (Slot.Generation + 1) & FPknuEntityHandle::GenerationMask;
+    if (Slot.Generation == 0) Slot.Generation = 1;
+    Slot.Name = Name;
+    Slot.WireHandle = 0;
+    Slot.bInUse = true;
+
+    const FPknuEntityHandle Handle = FPknuEntityHandle::Make(Index, Slot.Generation);
+    NameToHandle.Add(Name, Handle);
+    return Handle;
+}
+
+FPknuEntityHandle FPknuEntityHandleTable::BindWire(uint32 WireHandle, const FString& Name)
+{
+    const FPknuEntityHandle Handle = FindOrAdd(Name);
+    if (WireHandle == 0) return Handle;
+
+    FSlot& Slot = Slots[Handle.GetIndex()];
+    if (Slot.WireHandle != 0 && Slot.WireHandle != WireHandle)
+    {
+        UnbindWire(Slot.WireHandle);
+    }
+    Slot.WireHandle = WireHandle;
+
+    const int32 WireIndex = static_cast<int32>(WireHandle & FPknuEntityHandle::IndexMask);
+    if (WireIndex >= WireToLocal.Num())
+    {
+        WireToLocal.SetNum(WireIndex + 1);
+    }
+    WireToLocal[WireIndex] = Handle;
+    return Handle;
+}
+
+void FPknuEntityHandleTable::UnbindWire(uint32 WireHandle)
+{
+    const FPknuEntityHandle Handle = FindByWire(WireHandle);
+    if (!Handle.IsValid()) return;
+
+    Slots[Handle.GetIndex()].WireHandle = 0;
+    WireToLocal[WireHandle & FPknuEntityHandle::IndexMask] = FPknuEntityHandle();
+}
+
+FPknuEntityHandle FPknuEntityHandleTable::FindByWire(uint32 WireHandle) const
+{
+    const int32 WireIndex = static_cast<int32>(WireHandle & FPknuEntityHandle::IndexMask);
+    if (WireHandle == 0 || !WireToLocal.IsValidIndex(WireIndex)) return FPknuEntityHandle();
+
+    // 같은 인덱스의 이전 세대 핸들이면 무효
+    const FPknuEntityHandle Handle = WireToLocal[WireIndex];
+    const FSlot* Slot = FindSlot(Handle);
+    return (Slot && Slot->WireHandle == WireHandle) ? Handle : FPknuEntityHandle();
+}
+
+uint32 FPknuEntityHandleTable::GetWireHandle(FPknuEntityHandle Handle) const
+{
+    const FSlot* Slot = FindSlot(Handle);
+    return Slot ? Slot->WireHandle : 0;
+}
+
+const FString& FPknuEntityHandleTable::GetName(FPknuEntityHandle Handle) const
+{
+    const FSlot* Slot = FindSlot(Handle);
+    return Slot ? Slot->Name : FString::GetEmpty();
+}
+
+bool FPknuEntityHandleTable::IsAlive(FPknuEntityHandle Handle) const
+{
+    return FindSlot(Handle) != nullptr;
+}
+
+void FPknuEntityHandleTable::Release(FPknuEntityHandle Handle)
+{
+    const FSlot* Found = FindSlot(Handle);
+    if (!Found) return;
+
+    FSlot& Slot = Slots[Handle.GetIndex()];
+    UnbindWire(Slot.WireHandle);
+    NameToHandle.Remove(Slot.Name);
+    Slot.Name.Reset();
+    Slot.bInUse = false;
+    FreeIndices.Add(Handle.GetIndex());
+}
+
+void FPknuEntityHandleTable::ResetWireHandles()
+{
+    for (FSlot& Slot : Slots)
+    {
+        Slot.WireHandle = 0;
+    }
+    WireToLocal.Reset();
+}
+
+const FPknuEntityHandleTable::FSlot* FPknuEntityHandleTable::FindSlot(FPknuEntityHandle Handle) const
+{
+    if (!Handle.IsValid() || !Slots.IsValidIndex(static_cast<int32>(Handle.GetIndex()))) return nullptr;
+
+    const FSlot& Slot = Slots[Handle.GetIndex()];
+    return (Slot.bInUse && Slot.Generation == Handle.GetGeneration()) ? &Slot : nullptr;
+}
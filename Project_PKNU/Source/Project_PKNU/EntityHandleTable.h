@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 세대(generation)가 붙은 32비트 엔티티 핸들.
+ * 하위 IndexBits 는 슬롯 인덱스, 상위 비트는 세대. 슬롯이 재사용되면 세대가 바뀌므로 오래된 핸들은 매칭되지 않는다.
+ * 0 은 무효 핸들 (세대는 1부터 시작). 서버(server/handles.js)와 같은 레이아웃을 사용한다.
+ */
+struct FPknuEntityHandle
+{
+    static constexpr uint32 IndexBits = 20;
+    static constexpr uint32 IndexMask = (1u << IndexBits) - 1;
+    static constexpr uint32 GenerationMask = (1u << (32 - IndexBits)) - 1;
+
+    uint32 Value = 0;
+
+    FPknuEntityHandle() = default;
+    explicit FPknuEntityHandle(uint32 InValue) : Value(InValue) {}
+
+    static FPknuEntityHandle Make(uint32 Index, uint32 Generation)
+    {
+        return FPknuEntityHandle(((Generation & GenerationMask) << IndexBits) | (Index & IndexMask));
+    }
+
+    uint32 GetIndex() const { return Value & IndexMask; }
+    uint32 GetGeneration() const { return Value >> IndexBits; }
+    bool IsValid() const { return Value != 0; }
+
+    bool operator==(const FPknuEntityHandle& Other) const { return Value == Other.Value; }
+    bool operator!=(const FPknuEntityHandle& Other) const { return Value != Other.Value; }
+
+    friend uint32 GetTypeHash(const FPknuEntityHandle& Handle) { return Handle.Value; }
+};
+
+/**
+ * 엔티티 이름(플레이어 UUID / 월드 오브젝트 이름) <-> 핸들 테이블.
+ *
+ * 클라이언트의 모든 맵은 로컬 핸들을 키로 쓰고, 서버가 handle_map 으로 알려 준 와이어 핸들은
+ * 로컬 핸들에 연결만 해 둔다. 패킷 경로에서는 FindByWire (배열 인덱스 + 세대 비교) 만 사용하므로
+ * 문자열 해시/비교는 엔티티 등록 시 한 번만 일어난다.
+ * 서버가 핸들을 보내지 않는 경우(구버전 서버)에는 이름으로 FindOrAdd 해서 로컬 핸들만 사용한다.
+ */
+class PROJECT_PKNU_API FPknuEntityHandleTable
+{
+public:
+    FPknuEntityHandle Find(const FString& Name) const;
+    FPknuEntityHandle FindOrAdd(const FString& Name);
+
+    // handle_map 항목 처리: Name 의 로컬 핸들에 WireHandle 을 연결하고 로컬 핸들 반환
+    FPknuEntityHandle BindWire(uint32 WireHandle, const FString& Name);
+    void UnbindWire(uint32 WireHandle);
+
+    // 아직 연결되지 않았거나 세대가 다르면 무효 핸들
+    FPknuEntityHandle FindByWire(uint32 WireHandle) const;
+
+    // 0 이면 서버가 아직 핸들을 할당하지 않음
+    uint32 GetWireHandle(FPknuEntityHandle Handle) const;
+    const FString& GetName(FPknuEntityHandle Handle) const;
+    bool IsAlive(FPknuEntityHandle Handle) const;
+
+    // 슬롯을 반납 (세대가 올라가므로 Handle 을 가진 다른 맵 항목은 더 이상 매칭되지 않음)
+    void Release(FPknuEntityHandle Handle);
+
+    // 연결이 끊기면 서버 핸들만 무효화 (로컬 핸들은 유지)
+    void ResetWireHandles();
+
+private:
+    struct FSlot
+    {
+        FString Name;
+        uint32 Generation = 0;
+        uint32 WireHandle = 0;
+        bool bInUse = false;
+    };
+
+    const FSlot* FindSlot(FPknuEntityHandle Handle) const;
+
+    TArray<FSlot> Slots;
+    TArray<uint32> FreeIndices;
+    TMap<FString, FPknuEntityHandle> NameToHandle;
+    TArray<FPknuEntityHandle> WireToLocal; // 와이어 핸들의 인덱스 -> 로컬 핸들
+};
@@ -6,23 +6,8 @@
 #include "GameFramework/Character.h"
 #include "MyRemoteCharacter.generated.h"
 
-// 위치와 시간을 함께 저장할 구조체 정의
-USTRUCT()
-struct FTransformSnapshot
-{
-    GENERATED_BODY()
-
-    UPROPERTY()
-    FVector Location;
-
-    UPROPERTY()
-    FRotator Rotation;
-
-    UPROPERTY()
-    double Timestamp; // 서버에서 받은 시간을 저장
-};
-
-class UWidgetComponent;
+class URemoteAvatarSubsystem;
+enum class ERemoteAvatarSignificance : uint8;
 
 UCLASS()
 class PROJECT_PKNU_API AMyRemoteCharacter : public ACharacter
@@ -30,9 +15,7 @@ class PROJECT_PKNU_API AMyRemoteCharacter : public ACharacter
 	GENERATED_BODY()
 
 public:
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
-    UWidgetComponent* NameplateComponent;
-
+    // 이름표는 UNameplateSubsystem 의 오버레이 하나가 모든 캐릭터 것을 그림
     void SetName(const FString& Name);
 
     UPROPERTY(BlueprintReadOnly, Category = "Animation")
@@ -44,18 +27,33 @@ public:
     AMyRemoteCharacter();
 
     // 기존 함수를 타임스탬프를 받도록 수정
+    // 스냅샷은 URemoteAvatarSubsystem 이 보관하고 보간함 (이 액터는 기본적으로 Tick 하지 않음)
     void AddTransformSnapshot(const FVector& NewLocation, const FRotator& NewRotation, float NewSpeed, bool bNewIsFalling, double NewTimestamp);
 
-    virtual void Tick(float DeltaTime) override;
+    // URemoteAvatarSubsystem 이 등급이 바뀔 때 호출. 애니메이션 / 이동 / 이름표 갱신 주기를 보간 주기에 맞춤
+    void SetSignificance(ERemoteAvatarSignificance Significance, float TickInterval);
+
+    // URemoteAvatarPool 이 꺼낼 / 반납할 때 호출
+    // 반납: 아바타 등록 해제(스냅샷 버퍼 초기화), 이름표 제거, 숨김 / 충돌 / Tick 끔
+    // 꺼냄: Transform 위치로 옮기고 다시 보이게 한 뒤 새 아바타로 등록
+    void ActivateFromPool(const FTransform& Transform);
+    void DeactivateForPool();
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-    // 트랜스폼 스냅샷을 저장할 버퍼
-    TArray<FTransformSnapshot> TransformBuffer;
+    friend class URemoteAvatarSubsystem;
 
-    // 얼마만큼의 지연을 둘 것인지 (네트워크 상태에 따라 조절)
+    void RegisterWithAvatarSubsystem();
+    void UnregisterFromAvatarSubsystem();
+
+    // 얼마만큼의 지연을 둘 것인지. 시작값이며, 이후에는 URemoteAvatarSubsystem 이 도착 간격 지터로 자동 조절
+    // (Pknu.Avatar.AdaptiveDelay 0 이면 이 값 고정)
     UPROPERTY(EditAnywhere, Category = "Network Interpolation")
-    float InterpolationDelay = 0.1f; // 100ms
+    float InterpolationDelay = 0.35f; // 350ms (송신 주기 0.3초 + 여유)
+
+    // URemoteAvatarSubsystem 의 아바타 인덱스 (다른 아바타가 제거되면 서브시스템이 갱신)
+    int32 AvatarIndex = INDEX_NONE;
 };
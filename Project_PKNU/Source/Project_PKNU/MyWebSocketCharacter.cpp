@@ -2,8 +2,7 @@
 
 
 #include "MyWebSocketCharacter.h"
-#include "Components/WidgetComponent.h"
-#include "NameplateWidget.h"
+#include "NameplateSubsystem.h"
 #include "PknuGameInstance.h"
 #include "WebSocketManager.h"
 #include "Json.h"
@@ -21,20 +20,13 @@ AMyWebSocketCharacter::AMyWebSocketCharacter()
 {
     // 매 프레임마다 Tick 수행 여부
     PrimaryActorTick.bCanEverTick = true;
-
-    NameplateComponent = CreateDefaultSubobject<UWidgetComponent>(TEXT("NameplateComponent"));
-    NameplateComponent->SetupAttachment(RootComponent);
-    NameplateComponent->SetWidgetSpace(EWidgetSpace::Screen);
-    NameplateComponent->SetDrawSize(FVector2D(200, 30));
-
 }
 
 void AMyWebSocketCharacter::SetName(const FString& Name)
 {
-    UNameplateWidget* NameplateWidget = Cast<UNameplateWidget>(NameplateComponent->GetUserWidgetObject());
-    if (NameplateWidget)
+    if (UNameplateSubsystem* Nameplates = GetWorld()->GetSubsystem<UNameplateSubsystem>())
     {
-        NameplateWidget->SetName(Name);
+        Nameplates->SetNameplate(this, Name);
     }
 }
 
@@ -85,6 +77,11 @@ void AMyWebSocketCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
         WebSocketManager->UnregisterPlayerCharacter();
     }
 
+    if (UNameplateSubsystem* Nameplates = GetWorld()->GetSubsystem<UNameplateSubsystem>())
+    {
+        Nameplates->RemoveNameplate(this);
+    }
+
     // 부모의 메서드 호출
     Super::EndPlay(EndPlayReason);
 }
@@ -10,7 +10,6 @@
 #include "WebSocketManager.h"
 #include "MyWebSocketCharacter.generated.h"
 
-class UWidgetComponent;
 class UInputAction;
 
 UCLASS()
@@ -19,9 +18,7 @@ class PROJECT_PKNU_API AMyWebSocketCharacter : public APknuCharacter
 	GENERATED_BODY()
 
 public:
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
-    UWidgetComponent* NameplateComponent;
-
+    // 이름표는 UNameplateSubsystem 의 오버레이가 그림
     void SetName(const FString& Name);
 
 	// 생성자
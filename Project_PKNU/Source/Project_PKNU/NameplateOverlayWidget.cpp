@@ -0,0 +1,57 @@
+#include "NameplateOverlayWidget.h"
+#include "Rendering/DrawElements.h"
+
+namespace
+{
+    const FLinearColor NameColor(1.f, 1.f, 1.f);
+    const FLinearColor ShadowColor(0.f, 0.f, 0.f, 0.75f);
+    const FVector2f ShadowOffset(1.f, 1.f);
+}
+
+void UNameplateOverlayWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+
+    // 입력은 받지 않음
+    SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UNameplateOverlayWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    DrawItems.Reset();
+    if (const UNameplateSubsystem* Subsystem = Nameplates.Get())
+    {
+        Subsystem->BuildDrawList(MyGeometry, DrawItems);
+    }
+}
+
+int32 UNameplateOverlayWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+    const UNameplateSubsystem* Subsystem = Nameplates.Get();
+    if (!Subsystem || DrawItems.Num() == 0) return LayerId;
+
+    // 먼 것부터 정렬되어 있으므로 이름마다 그림자/글자 레이어를 하나씩 올려 그리면 가까운 이름이 먼 이름의 글자까지 덮음
+    // (모든 그림자와 글자를 각각 한 레이어에 모으면 가까운 이름의 그림자가 먼 이름의 글자 아래로 깔림)
+    const FSlateFontInfo& Font = Subsystem->GetFont();
+    int32 TextLayer = LayerId;
+    for (const FNameplateDrawItem& Item : DrawItems)
+    {
+        const int32 ShadowLayer = TextLayer + 1;
+        TextLayer += 2;
+        const float Opacity = Item.Opacity * InWidgetStyle.GetColorAndOpacityTint().A;
+
+        FSlateDrawElement::MakeText(OutDrawElements, ShadowLayer,
+            AllottedGeometry.ToPaintGeometry(Item.Size, FSlateLayoutTransform(Item.Position + ShadowOffset)),
+            Item.Name, Font, ESlateDrawEffect::None, ShadowColor.CopyWithNewOpacity(ShadowColor.A * Opacity));
+
+        FSlateDrawElement::MakeText(OutDrawElements, TextLayer,
+            AllottedGeometry.ToPaintGeometry(Item.Size, FSlateLayoutTransform(Item.Position)),
+            Item.Name, Font, ESlateDrawEffect::None, NameColor.CopyWithNewOpacity(Opacity));
+    }
+    return TextLayer;
+}
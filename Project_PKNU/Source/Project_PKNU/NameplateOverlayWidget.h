@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "NameplateSubsystem.h"
+#include "NameplateOverlayWidget.generated.h"
+
+/**
+ * UNameplateSubsystem 에 등록된 이름표를 한 번에 그리는 전체 화면 오버레이.
+ * NativeTick 에서 그릴 목록을 만들고 NativePaint 에서 글자만 출력한다 (자식 위젯 / 히트 테스트 없음).
+ */
+UCLASS()
+class PROJECT_PKNU_API UNameplateOverlayWidget : public UUserWidget
+{
+    GENERATED_BODY()
+
+public:
+    void SetNameplates(UNameplateSubsystem* InNameplates) { Nameplates = InNameplates; }
+
+protected:
+    virtual void NativeConstruct() override;
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+private:
+    TWeakObjectPtr<UNameplateSubsystem> Nameplates;
+    TArray<FNameplateDrawItem> DrawItems;
+};
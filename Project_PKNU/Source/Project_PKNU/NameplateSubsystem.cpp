@@ -0,0 +1,194 @@
+#include "NameplateSubsystem.h"
+#include "NameplateOverlayWidget.h"
+#include "Engine/World.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "Styling/CoreStyle.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarPknuNameplateMaxDistance(
+    TEXT("Pknu.Nameplate.MaxDistance"),
+    5000.f,
+    TEXT("이 거리(cm)보다 먼 캐릭터의 이름표는 그리지 않음."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuNameplateFadeDistance(
+    TEXT("Pknu.Nameplate.FadeDistance"),
+    1000.f,
+    TEXT("MaxDistance 앞의 이 구간(cm)에서 이름표가 점점 흐려짐. 0 이면 MaxDistance 에서 바로 사라짐."),
+    ECVF_Default);
+
+namespace
+{
+    // 캡슐 꼭대기와 이름표 사이 여유 (cm)
+    constexpr float AnchorPadding = 30.f;
+    constexpr int32 NameFontSize = 12;
+    // 오버레이는 채팅 / 로그인 UI 아래에 깔림
+    constexpr int32 OverlayZOrder = -10;
+}
+
+void UNameplateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Font = FCoreStyle::GetDefaultFontStyle("Bold", NameFontSize);
+}
+
+void UNameplateSubsystem::Deinitialize()
+{
+    if (Overlay)
+    {
+        Overlay->RemoveFromParent();
+        Overlay = nullptr;
+    }
+    EntryIndices.Empty();
+    Actors.Empty();
+    Names.Empty();
+    NameSizes.Empty();
+    AnchorHeights.Empty();
+    VisibleFlags.Empty();
+
+    Super::Deinitialize();
+}
+
+bool UNameplateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UNameplateSubsystem::EnsureOverlay()
+{
+    if (Overlay) return;
+
+    UWorld* World = GetWorld();
+    if (!World || !World->GetGameInstance()) return;
+
+    Overlay = CreateWidget<UNameplateOverlayWidget>(World, UNameplateOverlayWidget::StaticClass());
+    if (Overlay)
+    {
+        Overlay->SetNameplates(this);
+        Overlay->AddToViewport(OverlayZOrder);
+    }
+}
+
+FVector2f UNameplateSubsystem::MeasureName(const FText& Name) const
+{
+    if (!FSlateApplication::IsInitialized()) return FVector2f::ZeroVector;
+
+    const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+    return FVector2f(FontMeasure->Measure(Name, Font));
+}
+
+void UNameplateSubsystem::SetNameplate(AActor* Actor, const FString& Name)
+{
+    if (!Actor) return;
+
+    EnsureOverlay();
+
+    const FText NameText = FText::FromString(Name);
+    if (const int32* Found = EntryIndices.Find(Actor))
+    {
+        Names[*Found] = NameText;
+        NameSizes[*Found] = MeasureName(NameText);
+        return;
+    }
+
+    const int32 Index = Actors.Add(Actor);
+    Names.Add(NameText);
+    NameSizes.Add(MeasureName(NameText));
+    AnchorHeights.Add(Actor->GetSimpleCollisionHalfHeight() + AnchorPadding);
+    VisibleFlags.Add(true);
+    EntryIndices.Add(Actor, Index);
+}
+
+void UNameplateSubsystem::RemoveNameplate(AActor* Actor)
+{
+    int32 Index = INDEX_NONE;
+    if (!EntryIndices.RemoveAndCopyValue(Actor, Index)) return;
+
+    // 마지막 항목을 빈자리로 옮겨 배열을 조밀하게 유지
+    const int32 LastIndex = Actors.Num() - 1;
+    if (Index != LastIndex)
+    {
+        if (AActor* Moved = Actors[LastIndex].Get())
+        {
+            EntryIndices.Add(Moved, Index);
+        }
+    }
+
+    Actors.RemoveAtSwap(Index, EAllowShrinking::No);
+    Names.RemoveAtSwap(Index, EAllowShrinking::No);
+    NameSizes.RemoveAtSwap(Index, EAllowShrinking::No);
+    AnchorHeights.RemoveAtSwap(Index, EAllowShrinking::No);
+    VisibleFlags.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+void UNameplateSubsystem::SetNameplateVisible(AActor* Actor, bool bVisible)
+{
+    if (const int32* Found = EntryIndices.Find(Actor))
+    {
+        VisibleFlags[*Found] = bVisible;
+    }
+}
+
+void UNameplateSubsystem::BuildDrawList(const FGeometry& Geometry, TArray<FNameplateDrawItem>& OutItems) const
+{
+    if (Actors.Num() == 0) return;
+
+    const UWorld* World = GetWorld();
+    const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+    if (!LocalPlayer || !LocalPlayer->ViewportClient || !LocalPlayer->ViewportClient->Viewport) return;
+
+    // 시점 / 투영 행렬은 프레임에 한 번만 구함
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)) return;
+
+    const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+    const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+    const FIntPoint ViewportSize = LocalPlayer->ViewportClient->Viewport->GetSizeXY();
+    if (ViewportSize.X <= 0 || ViewportSize.Y <= 0) return;
+
+    // 뷰포트 픽셀 -> 오버레이 로컬 좌표 (DPI 스케일)
+    const FVector2f LocalSize = Geometry.GetLocalSize();
+    const FVector2f PixelToLocal(LocalSize.X / ViewportSize.X, LocalSize.Y / ViewportSize.Y);
+
+    const float MaxDistance = FMath::Max(CVarPknuNameplateMaxDistance.GetValueOnGameThread(), 0.f);
+    const float FadeDistance = FMath::Clamp(CVarPknuNameplateFadeDistance.GetValueOnGameThread(), 0.f, MaxDistance);
+    const float FadeStart = MaxDistance - FadeDistance;
+    const FVector ViewOrigin = ProjectionData.ViewOrigin;
+
+    for (int32 i = 0; i < Actors.Num(); ++i)
+    {
+        if (!VisibleFlags[i]) continue;
+
+        const AActor* Actor = Actors[i].Get();
+        if (!Actor || Actor->IsHidden()) continue;
+
+        const FVector Anchor = Actor->GetActorLocation() + FVector(0.0, 0.0, AnchorHeights[i]);
+        const float Distance = FVector::Dist(ViewOrigin, Anchor);
+        if (Distance > MaxDistance) continue;
+
+        FVector2D ScreenPosition;
+        if (!FSceneView::ProjectWorldToScreen(Anchor, ViewRect, ViewProjection, ScreenPosition)) continue; // 카메라 뒤
+
+        // 이름표 아래쪽 가운데가 기준점
+        const FVector2f Size = NameSizes[i];
+        const FVector2f Position = FVector2f(ScreenPosition) * PixelToLocal - FVector2f(Size.X * 0.5f, Size.Y);
+        if (Position.X + Size.X < 0.f || Position.Y + Size.Y < 0.f || Position.X > LocalSize.X || Position.Y > LocalSize.Y) continue;
+
+        FNameplateDrawItem& Item = OutItems.AddDefaulted_GetRef();
+        Item.Name = Names[i];
+        Item.Position = Position;
+        Item.Size = Size;
+        Item.Opacity = Distance <= FadeStart ? 1.f : 1.f - (Distance - FadeStart) / FMath::Max(FadeDistance, UE_SMALL_NUMBER);
+        Item.Distance = Distance;
+    }
+
+    OutItems.Sort([](const FNameplateDrawItem& A, const FNameplateDrawItem& B) { return A.Distance > B.Distance; });
+}
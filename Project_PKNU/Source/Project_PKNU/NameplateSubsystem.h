@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Fonts/SlateFontInfo.h"
+#include "NameplateSubsystem.generated.h"
+
+class UNameplateOverlayWidget;
+
+// 이번 프레임에 그릴 이름표 하나 (위젯 로컬 좌표)
+struct FNameplateDrawItem
+{
+    FText Name;
+    FVector2f Position = FVector2f::ZeroVector; // 글자 영역의 왼쪽 위
+    FVector2f Size = FVector2f::ZeroVector;
+    float Opacity = 1.f;
+    float Distance = 0.f;
+};
+
+/**
+ * 모든 캐릭터 이름표를 하나의 오버레이 위젯으로 그리는 월드 서브시스템.
+ *
+ * 캐릭터마다 screen space UWidgetComponent + UNameplateWidget 을 두면 이름표 수만큼 UMG 위젯이 따로 투영 / 레이아웃되므로,
+ * 이름과 기준 높이만 여기 등록하고 UNameplateOverlayWidget 이 프레임마다 한 번 BuildDrawList 로 전체를 투영해 그린다.
+ * 카메라 뒤 / 화면 밖 / Pknu.Nameplate.MaxDistance 보다 먼 이름표는 건너뛰고, 마지막 Pknu.Nameplate.FadeDistance 구간에서 흐려진다.
+ *
+ * 항목은 조밀한 배열로 두고 제거 시 마지막 항목을 빈자리로 옮긴다 (액터 -> 인덱스는 EntryIndices).
+ */
+UCLASS()
+class PROJECT_PKNU_API UNameplateSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // 등록되지 않은 액터면 새 항목을 만듦 (기준 높이는 충돌 반높이 + 여유)
+    void SetNameplate(AActor* Actor, const FString& Name);
+    void RemoveNameplate(AActor* Actor);
+    // 중요도가 낮은 캐릭터 등에서 이름표만 숨김 (항목은 유지)
+    void SetNameplateVisible(AActor* Actor, bool bVisible);
+
+    // 현재 첫 로컬 플레이어의 시점으로 모든 항목을 투영해 먼 것부터 OutItems 에 채움 (게임 스레드)
+    void BuildDrawList(const FGeometry& Geometry, TArray<FNameplateDrawItem>& OutItems) const;
+
+    const FSlateFontInfo& GetFont() const { return Font; }
+    int32 NumNameplates() const { return Actors.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void EnsureOverlay();
+    FVector2f MeasureName(const FText& Name) const;
+
+    UPROPERTY()
+    TObjectPtr<UNameplateOverlayWidget> Overlay;
+
+    FSlateFontInfo Font;
+    TMap<TObjectKey<AActor>, int32> EntryIndices;
+
+    // 항목별 (모두 같은 인덱스)
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    TArray<FText> Names;
+    TArray<FVector2f> NameSizes;   // 글자 크기 (SetNameplate 에서 한 번 측정)
+    TArray<float> AnchorHeights;   // 액터 위치에서 이름표 아래쪽까지 높이 (cm)
+    TArray<bool> VisibleFlags;
+};
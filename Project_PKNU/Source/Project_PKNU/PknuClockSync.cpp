@@ -0,0 +1,106 @@
+#include "PknuClockSync.h"
+
+namespace
+{
+    // 접속 직후 빠르게 보내는 ping 수와 간격, 이후의 간격 (초)
+    constexpr int32 BurstPingCount = 5;
+    constexpr double BurstPingInterval = 0.2;
+    constexpr double SteadyPingInterval = 2.0;
+
+    // 이보다 긴 왕복은 offset 오차가 너무 커서 버림
+    constexpr double MaxRoundTripSeconds = 2.0;
+
+    // 두 기준 샘플의 offset 오차는 각각 RTT / 2 이내이므로 기울기 오차는 (RTT_a + RTT_b) / 2 / 간격 이내.
+    // 이 값이 MaxDriftError 이하가 될 만큼 간격이 벌어진 뒤부터 drift 를 갱신 (RTT 50 ms 면 약 50 초 뒤).
+    // 최악의 경우 오차라 실제로는 훨씬 작고, anchor 를 바로 옮기지 않으므로 간격이 벌어질수록 측정값이 정확해짐
+    constexpr double MinDriftIntervalSeconds = 30.0;
+    constexpr double MaxDriftError = 1e-3;
+    constexpr double DriftGain = 0.5;
+    // 기울기 오차가 이만큼 작아졌거나 anchor 가 이만큼 오래되면 anchor 를 옮김 (온도 등으로 바뀌는 drift 를 따라가도록)
+    constexpr double ReanchorDriftError = 20e-6;
+    constexpr double MaxDriftAnchorAgeSeconds = 600.0;
+    // 일반적인 수정 발진기 오차보다 넉넉한 상한 (500 ppm)
+    constexpr double MaxDrift = 500e-6;
+}
+
+void FPknuClockSync::Reset()
+{
+    *this = FPknuClockSync();
+}
+
+bool FPknuClockSync::ShouldSendPing(double LocalTime) const
+{
+    if (NumPingsSent == 0) return true;
+
+    const double Interval = NumPingsSent < BurstPingCount ? BurstPingInterval : SteadyPingInterval;
+    return LocalTime - LastPingTime >= Interval;
+}
+
+void FPknuClockSync::OnPingSent(double LocalTime)
+{
+    ++NumPingsSent;
+    LastPingTime = LocalTime;
+}
+
+void FPknuClockSync::AddSample(double LocalSendTime, double ServerTimeMs, double LocalReceiveTime)
+{
+    const double RoundTrip = LocalReceiveTime - LocalSendTime;
+    if (RoundTrip < 0.0 || RoundTrip > MaxRoundTripSeconds) return;
+
+    FSample& Sample = Samples[NextSample];
+    Sample.LocalTime = (LocalSendTime + LocalReceiveTime) * 0.5;
+    Sample.OffsetMs = ServerTimeMs - Sample.LocalTime * 1000.0;
+    Sample.RoundTrip = RoundTrip;
+    NextSample = (NextSample + 1) % SampleWindow;
+    NumSamples = FMath::Min(NumSamples + 1, SampleWindow);
+
+    // 창 안에서 왕복이 가장 짧은 샘플 (같으면 최신)
+    const FSample* Best = &Samples[0];
+    for (int32 i = 1; i < NumSamples; ++i)
+    {
+        if (Samples[i].RoundTrip < Best->RoundTrip || (Samples[i].RoundTrip == Best->RoundTrip && Samples[i].LocalTime > Best->LocalTime))
+        {
+            Best = &Samples[i];
+        }
+    }
+    if (Best->LocalTime == BaseLocalTime) return;
+
+    const bool bFirstBase = BaseLocalTime == 0.0;
+    BaseLocalTime = Best->LocalTime;
+    BaseOffsetMs = Best->OffsetMs;
+    BaseRoundTrip = Best->RoundTrip;
+
+    if (bFirstBase)
+    {
+        DriftAnchorLocalTime = BaseLocalTime;
+        DriftAnchorOffsetMs = BaseOffsetMs;
+        DriftAnchorRoundTrip = BaseRoundTrip;
+        return;
+    }
+
+    const double Elapsed = BaseLocalTime - DriftAnchorLocalTime;
+    const double SlopeError = (DriftAnchorRoundTrip + BaseRoundTrip) * 0.5 / FMath::Max(Elapsed, UE_SMALL_NUMBER);
+    if (Elapsed >= MinDriftIntervalSeconds && SlopeError <= MaxDriftError)
+    {
+        const double Measured = (BaseOffsetMs - DriftAnchorOffsetMs) / (Elapsed * 1000.0);
+        Drift = FMath::Clamp(Drift + (Measured - Drift) * DriftGain, -MaxDrift, MaxDrift);
+
+        if (SlopeError <= ReanchorDriftError || Elapsed >= MaxDriftAnchorAgeSeconds)
+        {
+            DriftAnchorLocalTime = BaseLocalTime;
+            DriftAnchorOffsetMs = BaseOffsetMs;
+            DriftAnchorRoundTrip = BaseRoundTrip;
+        }
+    }
+}
+
+double FPknuClockSync::LocalToServerMs(double LocalTime) const
+{
+    return LocalTime * 1000.0 + OffsetAt(LocalTime);
+}
+
+double FPknuClockSync::ServerMsToLocal(double ServerTimeMs) const
+{
+    // ServerTimeMs = L * 1000 + BaseOffsetMs + Drift * 1000 * (L - BaseLocalTime) 를 L 에 대해 풂
+    return (ServerTimeMs - BaseOffsetMs + Drift * 1000.0 * BaseLocalTime) / (1000.0 * (1.0 + Drift));
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * ping / pong 으로 서버 시계(UTC ms)와 로컬 시계(FPlatformTime::Seconds) 의 관계를 추정한다.
+ *
+ * 샘플 하나 = (ping 을 보낸 로컬 시각 t0, pong 의 서버 시각 ts, pong 을 받은 로컬 시각 t1).
+ * 왕복이 대칭이라고 보면 offset = ts - (t0 + t1) / 2 이고 오차는 RTT / 2 이내이므로,
+ * 최근 SampleWindow 개 중 RTT 가 가장 짧은 샘플을 기준으로 삼는다 (NTP clock filter 와 같은 방식).
+ * 기준 샘플이 drift anchor 에서 RTT 오차가 충분히 작아질 만큼 떨어진 시각에 다시 잡히면 두 offset 의 기울기로
+ * 시계 속도 차(drift)를 갱신하고, 그 사이 시각은 기준 offset + drift 로 보정한다.
+ */
+class PROJECT_PKNU_API FPknuClockSync
+{
+public:
+    static constexpr int32 SampleWindow = 8;
+
+    // 송신 타임스탬프와 원격 캐릭터 스냅샷이 공유하는 로컬 시계 (월드 시간과 달리 멈추거나 늘어나지 않음)
+    static double LocalNow() { return FPlatformTime::Seconds(); }
+
+    void Reset();
+
+    // 처음에는 짧은 간격으로 여러 번, 동기화된 뒤에는 drift 추적용으로 가끔
+    bool ShouldSendPing(double LocalTime) const;
+    void OnPingSent(double LocalTime);
+
+    void AddSample(double LocalSendTime, double ServerTimeMs, double LocalReceiveTime);
+
+    bool IsSynchronized() const { return NumSamples >= MinSamplesForSync; }
+    double LocalToServerMs(double LocalTime) const;
+    double ServerMsToLocal(double ServerTimeMs) const;
+
+    double GetRoundTripTime() const { return BaseRoundTrip; }
+    double GetDriftPpm() const { return Drift * 1e6; }
+
+private:
+    static constexpr int32 MinSamplesForSync = 3;
+
+    struct FSample
+    {
+        double LocalTime = 0.0; // 왕복 중간 시각
+        double OffsetMs = 0.0;  // ServerTimeMs - LocalTime * 1000
+        double RoundTrip = 0.0;
+    };
+
+    double OffsetAt(double LocalTime) const { return BaseOffsetMs + Drift * 1000.0 * (LocalTime - BaseLocalTime); }
+
+    FSample Samples[SampleWindow];
+    int32 NextSample = 0;
+    int32 NumSamples = 0;
+    int32 NumPingsSent = 0;
+    double LastPingTime = 0.0;
+
+    // 현재 기준 샘플
+    double BaseLocalTime = 0.0;
+    double BaseOffsetMs = 0.0;
+    double BaseRoundTrip = 0.0;
+
+    // drift 는 DriftAnchor 이후 충분히 시간이 지난 기준 샘플과 비교해 갱신
+    double DriftAnchorLocalTime = 0.0;
+    double DriftAnchorOffsetMs = 0.0;
+    double DriftAnchorRoundTrip = 0.0;
+    double Drift = 0.0; // 서버 시계가 로컬보다 빠른 비율 (ms / ms)
+};
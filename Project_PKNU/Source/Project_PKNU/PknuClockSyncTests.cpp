@@ -0,0 +1,101 @@
+#include "PknuClockSync.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * FPknuClockSync 에 offset / drift 를 알고 있는 가상의 서버 시계로 만든 (t0, ts, t1) 샘플을 넣고
+ * LocalToServerMs / ServerMsToLocal 의 왕복과 drift 수렴을 확인.
+ */
+namespace
+{
+    struct FSimulatedServerClock
+    {
+        double OffsetMs = 0.0;
+        double Drift = 0.0; // 서버 시계가 로컬보다 빠른 비율
+
+        double ServerMsAt(double LocalTime) const { return LocalTime * 1000.0 * (1.0 + Drift) + OffsetMs; }
+    };
+
+    // ShouldSendPing 주기대로 ping 을 보내고 Until 까지 pong 을 받음.
+    // 네 번째 ping 마다 한쪽 경로만 느린 긴 왕복(offset 오차 200 ms)을 섞어, RTT 최소 샘플만 기준이 되는지 확인
+    void RunPings(FPknuClockSync& Sync, const FSimulatedServerClock& Server, FRandomStream& Random, int32& NumPings, double& LocalTime, double Until)
+    {
+        for (; LocalTime < Until; LocalTime += 0.05)
+        {
+            if (!Sync.ShouldSendPing(LocalTime)) continue;
+            Sync.OnPingSent(LocalTime);
+
+            const bool bAsymmetric = (++NumPings % 4) == 0;
+            const double RoundTrip = bAsymmetric ? 0.5 : Random.FRandRange(0.03f, 0.08f);
+            const double Upstream = bAsymmetric ? 0.45 : RoundTrip * 0.5;
+            Sync.AddSample(LocalTime, Server.ServerMsAt(LocalTime + Upstream), LocalTime + RoundTrip);
+        }
+    }
+
+    // 현재와 Ahead 초 뒤 (다음 기준 샘플 전까지 drift 로 외삽하는 구간) 를 확인
+    void TestConversions(FAutomationTestBase& Test, const FString& What, const FPknuClockSync& Sync, const FSimulatedServerClock& Server, double LocalTime, double Ahead)
+    {
+        for (const double Local : { LocalTime, LocalTime + Ahead })
+        {
+            const double ServerMs = Sync.LocalToServerMs(Local);
+            Test.TestNearlyEqual(What + TEXT(": LocalToServerMs"), ServerMs, Server.ServerMsAt(Local), 1.0);
+            Test.TestNearlyEqual(What + TEXT(": ServerMsToLocal(LocalToServerMs)"), Sync.ServerMsToLocal(ServerMs), Local, 1e-6);
+            Test.TestNearlyEqual(What + TEXT(": LocalToServerMs(ServerMsToLocal)"), Sync.LocalToServerMs(Sync.ServerMsToLocal(ServerMs)), ServerMs, 1e-3);
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuClockSyncTest, "Project_PKNU.Network.ClockSync",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuClockSyncTest::RunTest(const FString& Parameters)
+{
+    for (const double DriftPpm : { 120.0, -250.0 })
+    {
+        const FString What = FString::Printf(TEXT("drift %+.0f ppm"), DriftPpm);
+        const FSimulatedServerClock Server{ 1.7e12, DriftPpm * 1e-6 };
+        FRandomStream Random(7);
+        FPknuClockSync Sync;
+        int32 NumPings = 0;
+
+        // LocalNow 처럼 0 이 아닌 시각에서 시작 (BaseLocalTime 0 은 기준 샘플 없음으로 쓰임)
+        const double Start = 1000.0;
+        double LocalTime = Start;
+
+        RunPings(Sync, Server, Random, NumPings, LocalTime, Start + 0.3);
+        TestFalse(What + TEXT(": 샘플 3개 전에 동기화됨"), Sync.IsSynchronized());
+
+        RunPings(Sync, Server, Random, NumPings, LocalTime, Start + 1.0);
+        TestTrue(What + TEXT(": burst ping 뒤 동기화"), Sync.IsSynchronized());
+        // drift 를 모르는 동안은 외삽하면 drift 만큼 벌어지므로 현재 시각만
+        TestConversions(*this, What + TEXT(" (burst)"), Sync, Server, LocalTime, 0.0);
+
+        // anchor 에서 MinDriftIntervalSeconds(30 초) 전에는 drift 를 갱신하지 않음
+        RunPings(Sync, Server, Random, NumPings, LocalTime, Start + 29.0);
+        TestEqual(What + TEXT(": 30 초 전 drift"), Sync.GetDriftPpm(), 0.0);
+
+        // RTT 30~80 ms 면 기울기 오차 조건(MaxDriftError)으로 약 40~80 초 뒤부터 갱신하고,
+        // 기준 샘플마다 DriftGain 만큼 다가가므로 3 분이면 1 ppm 이내
+        RunPings(Sync, Server, Random, NumPings, LocalTime, Start + 180.0);
+        TestNearlyEqual(What + TEXT(": 3 분 뒤 drift"), Sync.GetDriftPpm(), DriftPpm, 1.0);
+        TestTrue(What + TEXT(": 기준은 RTT 최소 샘플"), Sync.GetRoundTripTime() < 0.1);
+        TestConversions(*this, What + TEXT(" (3 min)"), Sync, Server, LocalTime, 10.0);
+
+        // anchor 를 옮긴 뒤(MaxDriftAnchorAgeSeconds)에도 유지
+        RunPings(Sync, Server, Random, NumPings, LocalTime, Start + 900.0);
+        TestNearlyEqual(What + TEXT(": 15 분 뒤 drift"), Sync.GetDriftPpm(), DriftPpm, 1.0);
+        TestConversions(*this, What + TEXT(" (15 min)"), Sync, Server, LocalTime, 10.0);
+    }
+
+    // 너무 길거나 음수인 왕복은 버림
+    FPknuClockSync Sync;
+    Sync.AddSample(10.0, 1000.0, 9.0);
+    Sync.AddSample(10.0, 1000.0, 13.0);
+    TestEqual(TEXT("invalid round trip"), Sync.GetRoundTripTime(), 0.0);
+
+    return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,562 @@
+#include "PknuJsonPullParser.h"
+
+FPknuJsonPullParser::FPknuJsonPullParser(const TCHAR* InText, int32 InLength)
+    : Text(InText)
+    , Length(InLength)
+{
+}
+
+bool FPknuJsonPullParser::BeginObject()
+{
+    if (!Expect(TEXT('{'))) return false;
+    bFirstElement = true;
+    return true;
+}
+
+bool FPknuJsonPullParser::NextKey(FStringView& OutKey)
+{
+    if (bError) return false;
+
+    SkipWhitespace();
+    if (Peek() == TEXT('}'))
+    {
+        ++Pos;
+        bFirstElement = false; // 바깥 컨테이너 입장에서는 값 하나를 다 읽은 상태
+        return false;
+    }
+    if (!bFirstElement && !Expect(TEXT(','))) return false;
+    bFirstElement = false;
+
+    bool bHasEscape = false;
+    SkipWhitespace();
+    if (!ScanStringRaw(OutKey, bHasEscape)) return false;
+    return Expect(TEXT(':'));
+}
+
+bool FPknuJsonPullParser::BeginArray()
+{
+    if (!Expect(TEXT('['))) return false;
+    bFirstElement = true;
+    return true;
+}
+
+bool FPknuJsonPullParser::NextArrayElement()
+{
+    if (bError) return false;
+
+    SkipWhitespace();
+    if (Peek() == TEXT(']'))
+    {
+        ++Pos;
+        bFirstElement = false;
+        return false;
+    }
+    if (!bFirstElement && !Expect(TEXT(','))) return false;
+    bFirstElement = false;
+    return true;
+}
+
+namespace
+{
+    uint32 ParseHex4(const TCHAR* Digits)
+    {
+        uint32 Value = 0;
+        for (int32 Digit = 0; Digit < 4; ++Digit)
+        {
+            Value = (Value << 4) | FParse::HexDigit(Digits[Digit]);
+        }
+        return Value;
+    }
+
+    // TCHAR 가 UTF-16 (Windows) 이면 서로게이트 쌍으로, UTF-32 (Linux 등) 이면 코드 포인트 그대로
+    // UTF-32 에서 짝 없는 서로게이트는 유효한 문자가 아니므로 대체 문자로 바꿈
+    void AppendCodePoint(FString& Out, uint32 CodePoint)
+    {
+        if constexpr (sizeof(TCHAR) == 2)
+        {
+            if (CodePoint > 0xFFFF)
+            {
+                Out.AppendChar(static_cast<TCHAR>(0xD800 + ((CodePoint - 0x10000) >> 10)));
+                Out.AppendChar(static_cast<TCHAR>(0xDC00 + ((CodePoint - 0x10000) & 0x3FF)));
+                return;
+            }
+        }
+        else if (StringConv::IsHighSurrogate(CodePoint) || StringConv::IsLowSurrogate(CodePoint))
+        {
+            CodePoint = UNICODE_BOGUS_CHAR_CODEPOINT;
+        }
+        Out.AppendChar(static_cast<TCHAR>(CodePoint));
+    }
+}
+
+bool FPknuJsonPullParser::ReadString(FString& OutValue)
+{
+    SkipWhitespace();
+    if (Peek() != TEXT('"'))
+    {
+        SkipValue();
+        return false;
+    }
+
+    FStringView Raw;
+    bool bHasEscape = false;
+    if (!ScanStringRaw(Raw, bHasEscape)) return false;
+
+    // Reset 은 할당을 유지하므로 같은 필드를 반복해서 읽어도 재할당이 거의 없음
+    OutValue.Reset(Raw.Len());
+    if (!bHasEscape)
+    {
+        OutValue.AppendChars(Raw.GetData(), Raw.Len());
+        return true;
+    }
+
+    for (int32 i = 0; i < Raw.Len(); ++i)
+    {
+        const TCHAR Char = Raw[i];
+        if (Char != TEXT('\\') || i + 1 >= Raw.Len())
+        {
+            OutValue.AppendChar(Char);
+            continue;
+        }
+
+        const TCHAR Escaped = Raw[++i];
+        switch (Escaped)
+        {
+        case TEXT('b'): OutValue.AppendChar(TEXT('\b')); break;
+        case TEXT('f'): OutValue.AppendChar(TEXT('\f')); break;
+        case TEXT('n'): OutValue.AppendChar(TEXT('\n')); break;
+        case TEXT('r'): OutValue.AppendChar(TEXT('\r')); break;
+        case TEXT('t'): OutValue.AppendChar(TEXT('\t')); break;
+        case TEXT('u'):
+            if (i + 4 < Raw.Len())
+            {
+                uint32 CodePoint = ParseHex4(Raw.GetData() + i + 1);
+                i += 4;
+
+                // BMP 밖의 문자는 \uD8xx\uDCxx 쌍으로 오므로 합쳐서 하나의 코드 포인트로
+                if (StringConv::IsHighSurrogate(CodePoint) && i + 6 < Raw.Len() && Raw[i + 1] == TEXT('\\') && Raw[i + 2] == TEXT('u'))
+                {
+                    const uint32 Low = ParseHex4(Raw.GetData() + i + 3);
+                    if (StringConv::IsLowSurrogate(Low))
+                    {
+                        CodePoint = StringConv::EncodeSurrogate(static_cast<uint16>(CodePoint), static_cast<uint16>(Low));
+                        i += 6;
+                    }
+                }
+                AppendCodePoint(OutValue, CodePoint);
+            }
+            break;
+        default: OutValue.AppendChar(Escaped); break; // \" \\ \/
+        }
+    }
+    return true;
+}
+
+bool FPknuJsonPullParser::ReadNumber(double& OutValue)
+{
+    SkipWhitespace();
+    const TCHAR First = Peek();
+    if (First != TEXT('-') && !FChar::IsDigit(First))
+    {
+        SkipValue();
+        return false;
+    }
+
+    // 입력은 널 종료 FString 이므로 Atod 는 숫자가 아닌 문자에서 멈춤
+    OutValue = FCString::Atod(Text + Pos);
+    while (Pos < Length)
+    {
+        const TCHAR Char = Text[Pos];
+        if (!FChar::IsDigit(Char) && Char != TEXT('-') && Char != TEXT('+') && Char != TEXT('.') && Char != TEXT('e') && Char != TEXT('E'))
+        {
+            break;
+        }
+        ++Pos;
+    }
+    return true;
+}
+
+bool FPknuJsonPullParser::ReadBool(bool& bOutValue)
+{
+    SkipWhitespace();
+    if (Pos + 4 <= Length && FCString::Strncmp(Text + Pos, TEXT("true"), 4) == 0)
+    {
+        Pos += 4;
+        bOutValue = true;
+        return true;
+    }
+    if (Pos + 5 <= Length && FCString::Strncmp(Text + Pos, TEXT("false"), 5) == 0)
+    {
+        Pos += 5;
+        bOutValue = false;
+        return true;
+    }
+    SkipValue();
+    return false;
+}
+
+bool FPknuJsonPullParser::SkipValue()
+{
+    SkipWhitespace();
+    const TCHAR Char = Peek();
+
+    if (Char == TEXT('"'))
+    {
+        FStringView Raw;
+        bool bHasEscape = false;
+        return ScanStringRaw(Raw, bHasEscape);
+    }
+    if (Char == TEXT('{') || Char == TEXT('['))
+    {
+        // 중첩이 비정상적으로 깊은 입력에서 스택이 넘치지 않도록
+        if (SkipDepth >= MaxSkipDepth) return SetError();
+        ++SkipDepth;
+
+        bool bOk;
+        if (Char == TEXT('{'))
+        {
+            bOk = BeginObject();
+            FStringView Key;
+            while (bOk && NextKey(Key))
+            {
+                bOk = SkipValue();
+            }
+        }
+        else
+        {
+            bOk = BeginArray();
+            while (bOk && NextArrayElement())
+            {
+                bOk = SkipValue();
+            }
+        }
+
+        --SkipDepth;
+        return bOk && !bError;
+    }
+    if (Char == TEXT('-') || FChar::IsDigit(Char))
+    {
+        double Ignored;
+        return ReadNumber(Ignored);
+    }
+
+    // ReadBool 은 true / false 가 아니면 SkipValue 로 넘기므로 여기서는 리터럴만 직접 비교 (되돌아가면 무한 재귀)
+    for (const FStringView Literal : { FStringView(TEXT("true")), FStringView(TEXT("false")), FStringView(TEXT("null")) })
+    {
+        if (Pos + Literal.Len() <= Length && FCString::Strncmp(Text + Pos, Literal.GetData(), Literal.Len()) == 0)
+        {
+            Pos += Literal.Len();
+            return true;
+        }
+    }
+    return SetError();
+}
+
+void FPknuJsonPullParser::SkipWhitespace()
+{
+    while (Pos < Length && FChar::IsWhitespace(Text[Pos]))
+    {
+        ++Pos;
+    }
+}
+
+TCHAR FPknuJsonPullParser::Peek()
+{
+    return Pos < Length ? Text[Pos] : TEXT('\0');
+}
+
+bool FPknuJsonPullParser::Expect(TCHAR Char)
+{
+    SkipWhitespace();
+    if (Peek() != Char) return SetError();
+    ++Pos;
+    return true;
+}
+
+bool FPknuJsonPullParser::ScanStringRaw(FStringView& OutRaw, bool& bOutHasEscape)
+{
+    if (!Expect(TEXT('"'))) return false;
+
+    const int32 Start = Pos;
+    bOutHasEscape = false;
+    while (Pos < Length)
+    {
+        const TCHAR Char = Text[Pos];
+        if (Char == TEXT('"'))
+        {
+            OutRaw = FStringView(Text + Start, Pos - Start);
+            ++Pos;
+            return true;
+        }
+        if (Char == TEXT('\\'))
+        {
+            bOutHasEscape = true;
+            ++Pos;
+        }
+        ++Pos;
+    }
+    return SetError();
+}
+
+bool FPknuJsonPullParser::SetError()
+{
+    bError = true;
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// 타입 구조체
+// ---------------------------------------------------------------------------
+
+void FPknuNetEntityState::Reset()
+{
+    ID.Reset();
+    WireHandle = 0;
+    SourceHandle = 0;
+    PlayerName.Reset();
+    Location = FVector::ZeroVector;
+    Rotation = FRotator::ZeroRotator;
+    Speed = 0.f;
+    bIsFalling = false;
+    Timestamp = 0.0;
+    LinearVelocity = FVector::ZeroVector;
+    AngularVelocity = FVector::ZeroVector;
+    bHasPosition = false;
+    bHasRotation = false;
+}
+
+void FPknuInboundMessage::Reset()
+{
+    Type.Reset();
+    Action.Reset();
+    ID.Reset();
+    PlayerID.Reset();
+    Message.Reset();
+    bIsObject = false;
+    WireHandle = 0;
+    Timestamp = 0.0;
+    PingSentTime = 0.0;
+    ReleasedHandles.Reset();
+    BinaryVersion = 0;
+    bHasQuant = false;
+    QuantBounds = FBox(ForceInit);
+    PositionBits = 0;
+    RotationBits = 0;
+    State.Reset();
+    NumEntities = 0; // 원소는 지우지 않고 AddEntity 에서 재사용
+    NumObjects = 0;
+}
+
+FPknuNetEntityState& FPknuInboundMessage::AddEntity()
+{
+    if (NumEntities == Entities.Num())
+    {
+        Entities.AddDefaulted();
+    }
+    FPknuNetEntityState& Entity = Entities[NumEntities++];
+    Entity.Reset();
+    return Entity;
+}
+
+FPknuNetEntityState& FPknuInboundMessage::AddObject()
+{
+    if (NumObjects == Objects.Num())
+    {
+        Objects.AddDefaulted();
+    }
+    FPknuNetEntityState& Object = Objects[NumObjects++];
+    Object.Reset();
+    return Object;
+}
+
+// ---------------------------------------------------------------------------
+// 디코더
+// ---------------------------------------------------------------------------
+
+namespace
+{
+    // FStringView 의 == 는 대소문자를 무시하므로 키 비교는 명시적으로 구분
+    FORCEINLINE bool KeyIs(FStringView Key, const TCHAR* Name)
+    {
+        return Key.Equals(Name, ESearchCase::CaseSensitive);
+    }
+
+    bool ReadNumberAs(FPknuJsonPullParser& Parser, float& Out)
+    {
+        double Value = 0.0;
+        if (!Parser.ReadNumber(Value)) return false;
+        Out = static_cast<float>(Value);
+        return true;
+    }
+
+    bool ReadPosition(FPknuJsonPullParser& Parser, FVector& Out)
+    {
+        if (!Parser.BeginObject()) return false;
+        FStringView Key;
+        while (Parser.NextKey(Key))
+        {
+            if (KeyIs(Key, TEXT("x"))) Parser.ReadNumber(Out.X);
+            else if (KeyIs(Key, TEXT("y"))) Parser.ReadNumber(Out.Y);
+            else if (KeyIs(Key, TEXT("z"))) Parser.ReadNumber(Out.Z);
+            else Parser.SkipValue();
+        }
+        return !Parser.IsError();
+    }
+
+    bool ReadRotation(FPknuJsonPullParser& Parser, FRotator& Out)
+    {
+        if (!Parser.BeginObject()) return false;
+        FStringView Key;
+        while (Parser.NextKey(Key))
+        {
+            if (KeyIs(Key, TEXT("pitch"))) Parser.ReadNumber(Out.Pitch);
+            else if (KeyIs(Key, TEXT("yaw"))) Parser.ReadNumber(Out.Yaw);
+            else if (KeyIs(Key, TEXT("roll"))) Parser.ReadNumber(Out.Roll);
+            else Parser.SkipValue();
+        }
+        return !Parser.IsError();
+    }
+
+    void ReadMeta(FPknuJsonPullParser& Parser, FPknuNetEntityState& Out)
+    {
+        if (!Parser.BeginObject()) return;
+        FStringView Key;
+        while (Parser.NextKey(Key))
+        {
+            if (KeyIs(Key, TEXT("playerName"))) Parser.ReadString(Out.PlayerName);
+            else Parser.SkipValue();
+        }
+    }
+
+    // { position, rotation, speed, isFalling, ts, velocity, angularVelocity, meta }
+    void ReadState(FPknuJsonPullParser& Parser, FPknuNetEntityState& Out)
+    {
+        if (!Parser.BeginObject()) return;
+        FStringView Key;
+        while (Parser.NextKey(Key))
+        {
+            if (KeyIs(Key, TEXT("position"))) Out.bHasPosition = ReadPosition(Parser, Out.Location);
+            else if (KeyIs(Key, TEXT("rotation"))) Out.bHasRotation = ReadRotation(Parser, Out.Rotation);
+            else if (KeyIs(Key, TEXT("speed"))) ReadNumberAs(Parser, Out.Speed);
+            else if (KeyIs(Key, TEXT("isFalling"))) Parser.ReadBool(Out.bIsFalling);
+            else if (KeyIs(Key, TEXT("ts"))) Parser.ReadNumber(Out.Timestamp);
+            else if (KeyIs(Key, TEXT("velocity"))) ReadPosition(Parser, Out.LinearVelocity);
+            else if (KeyIs(Key, TEXT("angularVelocity"))) ReadPosition(Parser, Out.AngularVelocity);
+            else if (KeyIs(Key, TEXT("meta"))) ReadMeta(Parser, Out);
+            else Parser.SkipValue();
+        }
+    }
+
+    bool ReadHandle(FPknuJsonPullParser& Parser, uint32& Out)
+    {
+        double Value = 0.0;
+        if (!Parser.ReadNumber(Value)) return false;
+        Out = static_cast<uint32>(Value);
+        return true;
+    }
+
+    // { playerID | objectID | id, h, src, state }
+    void ReadEntityList(FPknuJsonPullParser& Parser, FPknuInboundMessage& Out, bool bObjects)
+    {
+        if (!Parser.BeginArray()) return;
+        while (Parser.NextArrayElement())
+        {
+            FPknuNetEntityState& Entity = bObjects ? Out.AddObject() : Out.AddEntity();
+            if (!Parser.BeginObject()) return;
+            FStringView Key;
+            while (Parser.NextKey(Key))
+            {
+                if (KeyIs(Key, TEXT("playerID")) || KeyIs(Key, TEXT("objectID")) || KeyIs(Key, TEXT("id"))) Parser.ReadString(Entity.ID);
+                else if (KeyIs(Key, TEXT("h"))) ReadHandle(Parser, Entity.WireHandle);
+                else if (KeyIs(Key, TEXT("src"))) ReadHandle(Parser, Entity.SourceHandle);
+                else if (KeyIs(Key, TEXT("state"))) ReadState(Parser, Entity);
+                else Parser.SkipValue();
+            }
+        }
+    }
+
+    bool ReadVectorArray(FPknuJsonPullParser& Parser, FVector& Out)
+    {
+        if (!Parser.BeginArray()) return false;
+        int32 Index = 0;
+        while (Parser.NextArrayElement())
+        {
+            double Value = 0.0;
+            if (Parser.ReadNumber(Value) && Index < 3)
+            {
+                Out[Index] = Value;
+            }
+            ++Index;
+        }
+        return !Parser.IsError() && Index == 3;
+    }
+
+    // hello_ack.quant : { min[3], max[3], positionBits, rotationBits }
+    void ReadQuant(FPknuJsonPullParser& Parser, FPknuInboundMessage& Out)
+    {
+        if (!Parser.BeginObject()) return;
+        bool bHasMin = false;
+        bool bHasMax = false;
+        double Bits = 0.0;
+        FStringView Key;
+        while (Parser.NextKey(Key))
+        {
+            if (KeyIs(Key, TEXT("min"))) bHasMin = ReadVectorArray(Parser, Out.QuantBounds.Min);
+            else if (KeyIs(Key, TEXT("max"))) bHasMax = ReadVectorArray(Parser, Out.QuantBounds.Max);
+            else if (KeyIs(Key, TEXT("positionBits")) && Parser.ReadNumber(Bits)) Out.PositionBits = static_cast<int32>(Bits);
+            else if (KeyIs(Key, TEXT("rotationBits")) && Parser.ReadNumber(Bits)) Out.RotationBits = static_cast<int32>(Bits);
+            else Parser.SkipValue();
+        }
+        Out.bHasQuant = bHasMin && bHasMax;
+        Out.QuantBounds.IsValid = Out.bHasQuant;
+    }
+}
+
+bool FPknuInboundDecoder::Decode(const FString& Json, FPknuInboundMessage& Out)
+{
+    Out.Reset();
+
+    FPknuJsonPullParser Parser(*Json, Json.Len());
+    if (!Parser.BeginObject()) return false;
+
+    // 서버는 type, action 을 항상 먼저 쓰지만, 순서에 의존하지 않도록 모든 필드를 한 번에 채운다
+    double Number = 0.0;
+    FStringView Key;
+    while (Parser.NextKey(Key))
+    {
+        if (KeyIs(Key, TEXT("type"))) Parser.ReadString(Out.Type);
+        else if (KeyIs(Key, TEXT("action"))) Parser.ReadString(Out.Action);
+        else if (KeyIs(Key, TEXT("id"))) Parser.ReadString(Out.ID);
+        else if (KeyIs(Key, TEXT("playerID"))) Parser.ReadString(Out.PlayerID);
+        else if (KeyIs(Key, TEXT("message"))) Parser.ReadString(Out.Message);
+        else if (KeyIs(Key, TEXT("isObject"))) Parser.ReadBool(Out.bIsObject);
+        else if (KeyIs(Key, TEXT("binary")) && Parser.ReadNumber(Number)) Out.BinaryVersion = static_cast<int32>(Number);
+        else if (KeyIs(Key, TEXT("quant"))) ReadQuant(Parser, Out);
+        else if (KeyIs(Key, TEXT("state"))) ReadState(Parser, Out.State);
+        else if (KeyIs(Key, TEXT("h"))) ReadHandle(Parser, Out.WireHandle);
+        else if (KeyIs(Key, TEXT("ts"))) Parser.ReadNumber(Out.Timestamp);
+        else if (KeyIs(Key, TEXT("t0"))) Parser.ReadNumber(Out.PingSentTime);
+        else if (KeyIs(Key, TEXT("playerCharacters")) || KeyIs(Key, TEXT("players")) || KeyIs(Key, TEXT("entries"))) ReadEntityList(Parser, Out, false);
+        else if (KeyIs(Key, TEXT("objects")) || KeyIs(Key, TEXT("worldObjects"))) ReadEntityList(Parser, Out, true);
+        else if (KeyIs(Key, TEXT("released")) && Parser.BeginArray())
+        {
+            while (Parser.NextArrayElement())
+            {
+                uint32 Released = 0;
+                if (ReadHandle(Parser, Released)) Out.ReleasedHandles.Add(Released);
+            }
+        }
+        // transform 메시지는 상태 필드가 루트에 평평하게 들어 있음
+        else if (KeyIs(Key, TEXT("x"))) Out.State.bHasPosition = Parser.ReadNumber(Out.State.Location.X);
+        else if (KeyIs(Key, TEXT("y"))) Parser.ReadNumber(Out.State.Location.Y);
+        else if (KeyIs(Key, TEXT("z"))) Parser.ReadNumber(Out.State.Location.Z);
+        else if (KeyIs(Key, TEXT("pitch"))) Out.State.bHasRotation = Parser.ReadNumber(Out.State.Rotation.Pitch);
+        else if (KeyIs(Key, TEXT("yaw"))) Parser.ReadNumber(Out.State.Rotation.Yaw);
+        else if (KeyIs(Key, TEXT("roll"))) Parser.ReadNumber(Out.State.Rotation.Roll);
+        else if (KeyIs(Key, TEXT("speed"))) ReadNumberAs(Parser, Out.State.Speed);
+        else if (KeyIs(Key, TEXT("isFalling"))) Parser.ReadBool(Out.State.bIsFalling);
+        else Parser.SkipValue();
+    }
+
+    return !Parser.IsError();
+}
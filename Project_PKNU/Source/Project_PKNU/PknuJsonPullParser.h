@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 트리를 만들지 않는 단일 패스 JSON 풀 파서.
+ * 호출자가 구조를 알고 있다는 전제로 BeginObject / NextKey / ReadXXX 를 순서대로 당겨 읽고,
+ * 모르는 키는 SkipValue 로 건너뛴다. 입력 문자열은 파싱이 끝날 때까지 살아 있어야 한다.
+ *
+ * 키는 원문을 가리키는 FStringView 로 돌려주므로 이스케이프가 들어간 키는 그대로(미해석) 비교된다.
+ */
+class PROJECT_PKNU_API FPknuJsonPullParser
+{
+public:
+    FPknuJsonPullParser(const TCHAR* InText, int32 InLength);
+
+    bool BeginObject();
+    // 다음 키를 읽고 ':' 까지 소비. 객체가 끝나면 '}' 를 소비하고 false
+    bool NextKey(FStringView& OutKey);
+
+    bool BeginArray();
+    // 다음 원소가 있으면 true. 배열이 끝나면 ']' 를 소비하고 false
+    bool NextArrayElement();
+
+    // 값 읽기. 타입이 다르면 값을 건너뛰고 false (에러는 아님)
+    bool ReadString(FString& OutValue);
+    bool ReadNumber(double& OutValue);
+    bool ReadBool(bool& bOutValue);
+    bool SkipValue();
+
+    bool IsError() const { return bError; }
+
+private:
+    void SkipWhitespace();
+    TCHAR Peek();
+    bool Expect(TCHAR Char);
+    bool ScanStringRaw(FStringView& OutRaw, bool& bOutHasEscape);
+    bool SetError();
+
+    static constexpr int32 MaxSkipDepth = 64;
+
+    const TCHAR* Text;
+    int32 Length;
+    int32 Pos = 0;
+    int32 SkipDepth = 0;
+    // NextKey / NextArrayElement 에서 첫 원소 앞에는 ',' 가 없음
+    bool bFirstElement = false;
+    bool bError = false;
+};
+
+// 서버 메시지에 등장하는 엔티티 상태 하나 (state 객체 또는 transform 의 평평한 필드)
+struct FPknuNetEntityState
+{
+    FString ID; // playerID / objectID
+    uint32 WireHandle = 0; // "h" : 서버가 할당한 엔티티 핸들 (구버전 서버는 0)
+    uint32 SourceHandle = 0; // "src" : update_batch.objects 에서 시뮬레이션 소유자(마지막으로 바꾼 플레이어)의 핸들
+    FString PlayerName; // state.meta.playerName (없으면 빈 문자열)
+    FVector Location = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    float Speed = 0.f;
+    bool bIsFalling = false;
+    double Timestamp = 0.0; // "ts" : 송신 시각 (서버 시계 기준 ms, 없으면 0)
+    FVector LinearVelocity = FVector::ZeroVector;  // "velocity" : 월드 오브젝트 (cm/s)
+    FVector AngularVelocity = FVector::ZeroVector; // "angularVelocity" : 월드 오브젝트 (deg/s)
+    bool bHasPosition = false;
+    bool bHasRotation = false;
+
+    void Reset();
+    bool HasTransform() const { return bHasPosition && bHasRotation; }
+};
+
+/**
+ * OnWebSocketMessage 가 처리하는 모든 텍스트 메시지의 필드를 담는 타입 구조체.
+ * 매 메시지마다 Reset 만 하고 재사용하므로 Entities 의 원소(와 그 안의 FString 버퍼)도 재사용된다.
+ */
+struct FPknuInboundMessage
+{
+    FString Type;
+    FString Action;
+    FString ID;
+    FString PlayerID;
+    FString Message;
+    bool bIsObject = false;
+    uint32 WireHandle = 0; // id / playerID 에 대응하는 "h"
+    double Timestamp = 0.0; // 루트의 "ts" (transform 의 송신 시각, pong 의 서버 시각)
+
+    // pong
+    double PingSentTime = 0.0; // "t0" : ping 에 담아 보낸 로컬 시각을 그대로 돌려받음
+
+    // hello_ack
+    int32 BinaryVersion = 0;
+    bool bHasQuant = false;
+    FBox QuantBounds = FBox(ForceInit);
+    int32 PositionBits = 0;
+    int32 RotationBits = 0;
+
+    // render_update 의 "state", 또는 transform 메시지의 루트 필드
+    FPknuNetEntityState State;
+
+    // handle_map.released
+    TArray<uint32> ReleasedHandles;
+
+    // state_sync.playerCharacters / update_batch.players / handle_map.entries
+    TArrayView<const FPknuNetEntityState> GetEntities() const { return MakeArrayView(Entities.GetData(), NumEntities); }
+
+    // update_batch.objects / state_sync.worldObjects
+    TArrayView<const FPknuNetEntityState> GetObjects() const { return MakeArrayView(Objects.GetData(), NumObjects); }
+
+    void Reset();
+    FPknuNetEntityState& AddEntity();
+    FPknuNetEntityState& AddObject();
+
+private:
+    TArray<FPknuNetEntityState> Entities;
+    int32 NumEntities = 0;
+    TArray<FPknuNetEntityState> Objects;
+    int32 NumObjects = 0;
+};
+
+struct PROJECT_PKNU_API FPknuInboundDecoder
+{
+    // Json 전체를 한 번만 훑어 Out 을 채움. 문법 오류면 false
+    static bool Decode(const FString& Json, FPknuInboundMessage& Out);
+};
@@ -0,0 +1,241 @@
+#include "PknuJsonPullParser.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * FPknuInboundDecoder 가 서버(server/server_code.js)가 보내는 텍스트 메시지를 모두 읽는지,
+ * 모르는 / 중첩된 필드를 건너뛰는지, 깨진 입력을 오류로 돌려주는지 확인.
+ */
+namespace
+{
+    bool DecodeInto(FAutomationTestBase& Test, const TCHAR* Json, FPknuInboundMessage& Out)
+    {
+        const bool bOk = FPknuInboundDecoder::Decode(FString(Json), Out);
+        Test.TestTrue(FString::Printf(TEXT("Decode: %s"), Json), bOk);
+        return bOk;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuJsonPullParserMessageTest, "Project_PKNU.Network.JsonPullParser.Messages",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuJsonPullParserMessageTest::RunTest(const FString& Parameters)
+{
+    // 한 메시지 구조체를 계속 재사용 (WebSocketManager 와 같은 방식)
+    FPknuInboundMessage Msg;
+
+    if (DecodeInto(*this, TEXT(R"({"type":"id","id":"player-1","h":1048576})"), Msg))
+    {
+        TestEqual(TEXT("id: type"), Msg.Type, TEXT("id"));
+        TestEqual(TEXT("id: id"), Msg.ID, TEXT("player-1"));
+        TestEqual(TEXT("id: h"), (int64)Msg.WireHandle, (int64)1048576);
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"handle_map","entries":[{"h":1048576,"id":"player-1"},{"h":2097153,"id":"crate"}],"released":[3145728]})"), Msg))
+    {
+        TestEqual(TEXT("handle_map: entries"), Msg.GetEntities().Num(), 2);
+        if (Msg.GetEntities().Num() == 2)
+        {
+            TestEqual(TEXT("handle_map: id"), Msg.GetEntities()[1].ID, TEXT("crate"));
+            TestEqual(TEXT("handle_map: h"), (int64)Msg.GetEntities()[1].WireHandle, (int64)2097153);
+        }
+        TestEqual(TEXT("handle_map: released"), Msg.ReleasedHandles.Num(), 1);
+        TestEqual(TEXT("handle_map: released h"), Msg.ReleasedHandles.Num() == 1 ? (int64)Msg.ReleasedHandles[0] : (int64)0, (int64)3145728);
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"pong","t0":1234.5,"ts":1700000000123})"), Msg))
+    {
+        TestEqual(TEXT("pong: t0"), Msg.PingSentTime, 1234.5);
+        TestEqual(TEXT("pong: ts"), Msg.Timestamp, 1700000000123.0);
+        TestEqual(TEXT("pong: 이전 메시지의 entries 가 남음"), Msg.GetEntities().Num(), 0);
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"hello_ack","binary":8,"quant":{"min":[-10000,-10000,-2000],"max":[10000,10000,2000],"positionBits":18,"rotationBits":9}})"), Msg))
+    {
+        TestEqual(TEXT("hello_ack: binary"), Msg.BinaryVersion, 8);
+        TestTrue(TEXT("hello_ack: quant"), Msg.bHasQuant && Msg.QuantBounds.IsValid);
+        TestEqual(TEXT("hello_ack: min"), Msg.QuantBounds.Min, FVector(-10000, -10000, -2000));
+        TestEqual(TEXT("hello_ack: max"), Msg.QuantBounds.Max, FVector(10000, 10000, 2000));
+        TestEqual(TEXT("hello_ack: positionBits"), Msg.PositionBits, 18);
+        TestEqual(TEXT("hello_ack: rotationBits"), Msg.RotationBits, 9);
+    }
+
+    // 버전 불일치면 quant 가 없음 / 원소가 3개가 아닌 quant 는 채택하지 않음
+    if (DecodeInto(*this, TEXT(R"({"type":"hello_ack","binary":0})"), Msg))
+    {
+        TestEqual(TEXT("hello_ack(json): binary"), Msg.BinaryVersion, 0);
+        TestFalse(TEXT("hello_ack(json): quant"), Msg.bHasQuant);
+    }
+    if (DecodeInto(*this, TEXT(R"({"type":"hello_ack","binary":8,"quant":{"min":[0,0],"max":[1,1,1],"positionBits":18,"rotationBits":9}})"), Msg))
+    {
+        TestFalse(TEXT("hello_ack(short min): quant"), Msg.bHasQuant);
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"render_update","action":"add_character","playerID":"p2","h":1048577,)")
+        TEXT(R"("state":{"position":{"x":1.5,"y":-2,"z":3e2},"rotation":{"pitch":0,"yaw":90,"roll":-45},"speed":0,"isFalling":false,"meta":{"playerName":"Kim"}}})"), Msg))
+    {
+        TestEqual(TEXT("add_character: action"), Msg.Action, TEXT("add_character"));
+        TestEqual(TEXT("add_character: playerID"), Msg.PlayerID, TEXT("p2"));
+        TestEqual(TEXT("add_character: h"), (int64)Msg.WireHandle, (int64)1048577);
+        TestTrue(TEXT("add_character: transform"), Msg.State.HasTransform());
+        TestEqual(TEXT("add_character: position"), Msg.State.Location, FVector(1.5, -2, 300));
+        TestEqual(TEXT("add_character: rotation"), Msg.State.Rotation, FRotator(0, 90, -45));
+        TestEqual(TEXT("add_character: playerName"), Msg.State.PlayerName, TEXT("Kim"));
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"render_update","action":"remove_character","playerID":"p2","h":1048577})"), Msg))
+    {
+        TestEqual(TEXT("remove_character: playerID"), Msg.PlayerID, TEXT("p2"));
+        TestFalse(TEXT("remove_character: 이전 메시지의 state 가 남음"), Msg.State.HasTransform() || !Msg.State.PlayerName.IsEmpty());
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"render_update","action":"add_object","id":"crate","h":2097153,"isObject":true,)")
+        TEXT(R"("state":{"position":{"x":10,"y":20,"z":30},"rotation":{"pitch":1,"yaw":2,"roll":3},"velocity":{"x":100,"y":0,"z":-50},"angularVelocity":{"x":0,"y":0,"z":45}}})"), Msg))
+    {
+        TestEqual(TEXT("add_object: id"), Msg.ID, TEXT("crate"));
+        TestTrue(TEXT("add_object: isObject"), Msg.bIsObject);
+        TestEqual(TEXT("add_object: position"), Msg.State.Location, FVector(10, 20, 30));
+        TestEqual(TEXT("add_object: velocity"), Msg.State.LinearVelocity, FVector(100, 0, -50));
+        TestEqual(TEXT("add_object: angularVelocity"), Msg.State.AngularVelocity, FVector(0, 0, 45));
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"render_update","action":"update_batch","serverTime":1700000000200,)")
+        TEXT(R"("players":[{"playerID":"p1","h":1048576,"state":{"position":{"x":1,"y":2,"z":3},"rotation":{"pitch":0,"yaw":180,"roll":0},"speed":600,"isFalling":true,"ts":1700000000150}}],)")
+        TEXT(R"("objects":[{"objectID":"crate","h":2097153,"src":1048576,"state":{"position":{"x":4,"y":5,"z":6},"rotation":{"pitch":0,"yaw":0,"roll":0},"velocity":{"x":1,"y":2,"z":3}}}]})"), Msg))
+    {
+        if (TestEqual(TEXT("update_batch: players"), Msg.GetEntities().Num(), 1))
+        {
+            const FPknuNetEntityState& Player = Msg.GetEntities()[0];
+            TestEqual(TEXT("update_batch: player id"), Player.ID, TEXT("p1"));
+            TestEqual(TEXT("update_batch: player speed"), Player.Speed, 600.f);
+            TestTrue(TEXT("update_batch: player isFalling"), Player.bIsFalling);
+            TestEqual(TEXT("update_batch: player ts"), Player.Timestamp, 1700000000150.0);
+        }
+        if (TestEqual(TEXT("update_batch: objects"), Msg.GetObjects().Num(), 1))
+        {
+            const FPknuNetEntityState& Object = Msg.GetObjects()[0];
+            TestEqual(TEXT("update_batch: object id"), Object.ID, TEXT("crate"));
+            TestEqual(TEXT("update_batch: object src"), (int64)Object.SourceHandle, (int64)1048576);
+            TestEqual(TEXT("update_batch: object velocity"), Object.LinearVelocity, FVector(1, 2, 3));
+        }
+    }
+
+    if (DecodeInto(*this, TEXT(R"({"type":"state_sync","initialized":true,)")
+        TEXT(R"("worldObjects":[{"objectID":"a","h":1,"state":{}},{"objectID":"b","h":2,"state":{}}],)")
+        TEXT(R"("playerCharacters":[{"playerID":"p1","h":3,"state":{"position":{"x":0,"y":0,"z":0},"rotation":{"pitch":0,"yaw":0,"roll":0}}}]})"), Msg))
+    {
+        TestEqual(TEXT("state_sync: worldObjects"), Msg.GetObjects().Num(), 2);
+        TestEqual(TEXT("state_sync: playerCharacters"), Msg.GetEntities().Num(), 1);
+        TestTrue(TEXT("state_sync: player transform"), Msg.GetEntities().Num() == 1 && Msg.GetEntities()[0].HasTransform());
+    }
+
+    // transform 은 상태 필드가 루트에 평평하게 들어 있음
+    if (DecodeInto(*this, TEXT(R"({"type":"transform","playerID":"p1","h":1048576,"x":1,"y":2,"z":3,"pitch":4,"yaw":5,"roll":6,"speed":7,"isFalling":true,"ts":99})"), Msg))
+    {
+        TestTrue(TEXT("transform: transform"), Msg.State.HasTransform());
+        TestEqual(TEXT("transform: position"), Msg.State.Location, FVector(1, 2, 3));
+        TestEqual(TEXT("transform: rotation"), Msg.State.Rotation, FRotator(4, 5, 6));
+        TestEqual(TEXT("transform: speed"), Msg.State.Speed, 7.f);
+        TestEqual(TEXT("transform: ts"), Msg.Timestamp, 99.0);
+    }
+
+    // 이스케이프와 BMP 밖 문자 (\ud83d\ude00 쌍은 TCHAR 폭과 관계없이 원문의 😀 과 같은 문자열이 되어야 함)
+    if (DecodeInto(*this, TEXT(R"({"type":"render_update","action":"new_chat","playerID":"Kim","message":"a\"b\\c\n\u00e9\ud83d\ude00 😀\/"})"), Msg))
+    {
+        TestEqual(TEXT("new_chat: message"), Msg.Message, FString(TEXT("a\"b\\c\né\U0001F600 \U0001F600/")));
+    }
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuJsonPullParserSkipTest, "Project_PKNU.Network.JsonPullParser.SkipUnknown",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuJsonPullParserSkipTest::RunTest(const FString& Parameters)
+{
+    FPknuInboundMessage Msg;
+
+    // 모르는 키가 중첩 객체 / 배열 / 리터럴 / 구분자가 들어간 문자열이어도 뒤의 필드를 읽어야 함 (키 순서에도 의존하지 않음)
+    if (DecodeInto(*this, TEXT(R"({ "extra" : { "a" : [ 1, { "b" : null }, [ ] ], "c" : "},]\"" }, "flag" : false, "n" : null, "neg" : -1.5e-3,)")
+        TEXT(R"( "t0" : 5, "list" : [ true, "x", { } ], "type" : "pong" })"), Msg))
+    {
+        TestEqual(TEXT("type"), Msg.Type, TEXT("pong"));
+        TestEqual(TEXT("t0"), Msg.PingSentTime, 5.0);
+    }
+
+    // 엔티티 / state / meta 안의 모르는 필드, 타입이 다른 값은 건너뛰고 기본값 유지
+    if (DecodeInto(*this, TEXT(R"({"type":"render_update","action":"update_batch","players":[{"extra":{"deep":[[1]]},"playerID":"p1","h":"bad",)")
+        TEXT(R"("state":{"speed":"fast","unknown":[1,2],"position":{"x":1,"w":9,"y":2,"z":3},"meta":{"color":"red","playerName":"Lee"},"isFalling":1}}]})"), Msg))
+    {
+        if (TestEqual(TEXT("players"), Msg.GetEntities().Num(), 1))
+        {
+            const FPknuNetEntityState& Player = Msg.GetEntities()[0];
+            TestEqual(TEXT("playerID"), Player.ID, TEXT("p1"));
+            TestEqual(TEXT("h (문자열)"), (int64)Player.WireHandle, (int64)0);
+            TestEqual(TEXT("speed (문자열)"), Player.Speed, 0.f);
+            TestFalse(TEXT("isFalling (숫자)"), Player.bIsFalling);
+            TestEqual(TEXT("position"), Player.Location, FVector(1, 2, 3));
+            TestEqual(TEXT("playerName"), Player.PlayerName, TEXT("Lee"));
+        }
+    }
+
+    // 이스케이프가 들어간 키는 원문 그대로 비교되므로 모르는 키로 취급
+    if (DecodeInto(*this, TEXT(R"({"type":"pong","\u0074ype":"id"})"), Msg))
+    {
+        TestEqual(TEXT("escaped key"), Msg.Type, TEXT("pong"));
+    }
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPknuJsonPullParserMalformedTest, "Project_PKNU.Network.JsonPullParser.Malformed",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPknuJsonPullParserMalformedTest::RunTest(const FString& Parameters)
+{
+    const TCHAR* Inputs[] =
+    {
+        TEXT(""),
+        TEXT("   "),
+        TEXT("[1,2]"),
+        TEXT("\"type\""),
+        TEXT("{"),
+        TEXT(R"({"type")"),
+        TEXT(R"({"type":)"),
+        TEXT(R"({"type":"id")"),
+        TEXT(R"({"type":"id)"),
+        TEXT(R"({"type":"id\)"),
+        TEXT(R"({"type" "id"})"),
+        TEXT(R"({"type":"id" "h":1})"),
+        TEXT(R"({"type":"id",})"),
+        TEXT(R"({type:"id"})"),
+        TEXT(R"({"extra":tru})"),
+        TEXT(R"({"isObject":nul})"),
+        TEXT(R"({"extra":[1,2})"),
+        TEXT(R"({"extra":{"a":1]})"),
+        TEXT(R"({"state":{"position":{"x":1})"),
+        TEXT(R"({"players":[{"playerID":"p1"})"),
+        TEXT(R"({"quant":{"min":[0,0,0)"),
+    };
+
+    FPknuInboundMessage Msg;
+    for (const TCHAR* Input : Inputs)
+    {
+        TestFalse(FString::Printf(TEXT("Decode: %s"), Input), FPknuInboundDecoder::Decode(FString(Input), Msg));
+    }
+
+    // 중첩이 아주 깊은 모르는 값은 스택을 소모하지 않고 오류
+    const FString Deep = TEXT("{\"extra\":") + FString::ChrN(10000, TEXT('[')) + FString::ChrN(10000, TEXT(']')) + TEXT("}");
+    TestFalse(TEXT("Decode: deep nesting"), FPknuInboundDecoder::Decode(Deep, Msg));
+
+    // 실패한 뒤에도 같은 구조체로 다음 메시지를 정상적으로 읽음
+    if (DecodeInto(*this, TEXT(R"({"type":"id","id":"p1"})"), Msg))
+    {
+        TestEqual(TEXT("after error: id"), Msg.ID, TEXT("p1"));
+    }
+
+    return !HasAnyErrors();
+}
+
+#endif
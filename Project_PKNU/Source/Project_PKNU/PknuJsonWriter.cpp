@@ -0,0 +1,207 @@
+#include "PknuJsonWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "Json.h"
+
+void FPknuJsonWriter::BeginObject()
+{
+    // 용량은 유지한 채 내용만 비움
+    Buffer.Reset();
+    IndentLevel = 0;
+
+    Buffer.AppendChar(TEXT('{'));
+    ++IndentLevel;
+    PreviousToken = EToken::CurlyOpen;
+}
+
+void FPknuJsonWriter::BeginObject(const TCHAR* Key)
+{
+    WriteIdentifier(Key);
+    WriteLineTerminatorAndTabs();
+    Buffer.AppendChar(TEXT('{'));
+    ++IndentLevel;
+    PreviousToken = EToken::CurlyOpen;
+}
+
+void FPknuJsonWriter::EndObject()
+{
+    --IndentLevel;
+    WriteLineTerminatorAndTabs();
+    Buffer.AppendChar(TEXT('}'));
+    PreviousToken = EToken::CurlyClose;
+}
+
+void FPknuJsonWriter::WriteString(const TCHAR* Key, const FString& Value)
+{
+    WriteIdentifier(Key);
+    Buffer.AppendChar(TEXT(' '));
+    AppendEscaped(*Value, Value.Len());
+    PreviousToken = EToken::Value;
+}
+
+void FPknuJsonWriter::WriteString(const TCHAR* Key, const TCHAR* Value)
+{
+    WriteIdentifier(Key);
+    Buffer.AppendChar(TEXT(' '));
+    AppendEscaped(Value, FCString::Strlen(Value));
+    PreviousToken = EToken::Value;
+}
+
+void FPknuJsonWriter::WriteNumber(const TCHAR* Key, double Value)
+{
+    WriteIdentifier(Key);
+    Buffer.AppendChar(TEXT(' '));
+
+    // TJsonPrintPolicy::WriteDouble 과 같은 형식 (유효숫자 17자리)
+    TCHAR Digits[64];
+    const int32 Len = FCString::Snprintf(Digits, UE_ARRAY_COUNT(Digits), TEXT("%.17g"), Value);
+    Buffer.AppendChars(Digits, FMath::Clamp(Len, 0, (int32)UE_ARRAY_COUNT(Digits) - 1));
+    PreviousToken = EToken::Value;
+}
+
+void FPknuJsonWriter::WriteBool(const TCHAR* Key, bool bValue)
+{
+    WriteIdentifier(Key);
+    Buffer.AppendChar(TEXT(' '));
+    if (bValue)
+    {
+        Buffer.AppendChars(TEXT("true"), 4);
+    }
+    else
+    {
+        Buffer.AppendChars(TEXT("false"), 5);
+    }
+    PreviousToken = EToken::Value;
+}
+
+void FPknuJsonWriter::WriteIdentifier(const TCHAR* Key)
+{
+    WriteCommaIfNeeded();
+    WriteLineTerminatorAndTabs();
+    AppendEscaped(Key, FCString::Strlen(Key));
+    Buffer.AppendChar(TEXT(':'));
+}
+
+void FPknuJsonWriter::WriteCommaIfNeeded()
+{
+    if (PreviousToken != EToken::CurlyOpen && PreviousToken != EToken::None)
+    {
+        Buffer.AppendChar(TEXT(','));
+    }
+}
+
+void FPknuJsonWriter::WriteLineTerminatorAndTabs()
+{
+    Buffer.AppendChars(LINE_TERMINATOR, UE_ARRAY_COUNT(LINE_TERMINATOR) - 1);
+    for (int32 i = 0; i < IndentLevel; ++i)
+    {
+        Buffer.AppendChar(TEXT('\t'));
+    }
+}
+
+void FPknuJsonWriter::AppendEscaped(const TCHAR* Str, int32 Len)
+{
+    // TJsonWriter::WriteStringValue 의 이스케이프 규칙과 동일
+    Buffer.AppendChar(TEXT('"'));
+    for (int32 i = 0; i < Len; ++i)
+    {
+        const TCHAR Char = Str[i];
+        switch (Char)
+        {
+        case TEXT('\\'): Buffer.AppendChars(TEXT("\\\\"), 2); break;
+        case TEXT('\n'): Buffer.AppendChars(TEXT("\\n"), 2); break;
+        case TEXT('\t'): Buffer.AppendChars(TEXT("\\t"), 2); break;
+        case TEXT('\b'): Buffer.AppendChars(TEXT("\\b"), 2); break;
+        case TEXT('\f'): Buffer.AppendChars(TEXT("\\f"), 2); break;
+        case TEXT('\r'): Buffer.AppendChars(TEXT("\\r"), 2); break;
+        case TEXT('"'):  Buffer.AppendChars(TEXT("\\\""), 2); break;
+        default:
+            if (Char >= TEXT(' '))
+            {
+                Buffer.AppendChar(Char);
+            }
+            else
+            {
+                TCHAR Escaped[8];
+                const int32 EscapedLen = FCString::Snprintf(Escaped, UE_ARRAY_COUNT(Escaped), TEXT("\\u%04x"), (uint32)Char);
+                Buffer.AppendChars(Escaped, EscapedLen);
+            }
+            break;
+        }
+    }
+    Buffer.AppendChar(TEXT('"'));
+}
+
+// ---------------------------------------------------------------------------
+// 벤치마크: 기존 FJsonObject 경로와 스트리밍 작성기로 같은 transform 메시지를 만들어 비교
+// ---------------------------------------------------------------------------
+
+static FAutoConsoleCommand GPknuBenchJsonWriterCommand(
+    TEXT("Pknu.Net.BenchJsonWriter"),
+    TEXT("Compares the FJsonObject send path with FPknuJsonWriter. Usage: Pknu.Net.BenchJsonWriter [Iterations]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+        const FString ID = TEXT("3f0b2c1e-8d4a-4c55-9a7e-2b1f0e6d9c33");
+        const FVector Loc(1234.5678, -9876.54321, 88.125);
+        const FRotator Rot(-3.25, 179.875, 0.5);
+        const double Speed = 412.75;
+        const bool bIsFalling = true;
+        const double Timestamp = 1760000000123.0;
+
+        FString DomOutput;
+        const double DomStart = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+            Root->SetStringField(TEXT("type"), TEXT("transform"));
+            Root->SetStringField(TEXT("id"), ID);
+            Root->SetNumberField(TEXT("x"), Loc.X);
+            Root->SetNumberField(TEXT("y"), Loc.Y);
+            Root->SetNumberField(TEXT("z"), Loc.Z);
+            Root->SetNumberField(TEXT("pitch"), Rot.Pitch);
+            Root->SetNumberField(TEXT("yaw"), Rot.Yaw);
+            Root->SetNumberField(TEXT("roll"), Rot.Roll);
+            Root->SetNumberField(TEXT("speed"), Speed);
+            Root->SetBoolField(TEXT("isFalling"), bIsFalling);
+            Root->SetNumberField(TEXT("ts"), Timestamp);
+
+            DomOutput.Reset();
+            TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&DomOutput);
+            FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+        }
+        const double DomSeconds = FPlatformTime::Seconds() - DomStart;
+
+        FPknuJsonWriter StreamWriter;
+        const double StreamStart = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            StreamWriter.BeginObject();
+            StreamWriter.WriteString(TEXT("type"), TEXT("transform"));
+            StreamWriter.WriteString(TEXT("id"), ID);
+            StreamWriter.WriteNumber(TEXT("x"), Loc.X);
+            StreamWriter.WriteNumber(TEXT("y"), Loc.Y);
+            StreamWriter.WriteNumber(TEXT("z"), Loc.Z);
+            StreamWriter.WriteNumber(TEXT("pitch"), Rot.Pitch);
+            StreamWriter.WriteNumber(TEXT("yaw"), Rot.Yaw);
+            StreamWriter.WriteNumber(TEXT("roll"), Rot.Roll);
+            StreamWriter.WriteNumber(TEXT("speed"), Speed);
+            StreamWriter.WriteBool(TEXT("isFalling"), bIsFalling);
+            StreamWriter.WriteNumber(TEXT("ts"), Timestamp);
+            StreamWriter.EndObject();
+        }
+        const double StreamSeconds = FPlatformTime::Seconds() - StreamStart;
+
+        const bool bIdentical = DomOutput.Equals(StreamWriter.GetOutput(), ESearchCase::CaseSensitive);
+        UE_LOG(LogTemp, Log, TEXT("BenchJsonWriter: %d iterations, FJsonObject %.3f us/msg, FPknuJsonWriter %.3f us/msg (x%.1f), output %s"),
+            Iterations,
+            DomSeconds * 1e6 / Iterations,
+            StreamSeconds * 1e6 / Iterations,
+            StreamSeconds > 0.0 ? DomSeconds / StreamSeconds : 0.0,
+            bIdentical ? TEXT("identical") : TEXT("DIFFERENT"));
+
+        if (!bIdentical)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FJsonObject:\n%s\nFPknuJsonWriter:\n%s"), *DomOutput, *StreamWriter.GetOutput());
+        }
+    }));
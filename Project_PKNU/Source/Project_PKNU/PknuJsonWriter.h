@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FJsonObject 트리를 만들지 않고 바로 텍스트를 쓰는 JSON 작성기.
+ * 출력은 TJsonWriterFactory<>::Create + FJsonSerializer::Serialize (pretty print 정책) 결과와 바이트 단위로 같다.
+ * 내부 버퍼는 매 메시지마다 Reset 만 하므로, 한 번 충분한 크기로 자란 뒤에는 추가 할당이 없다.
+ *
+ * 비교 벤치마크: 콘솔 명령 Pknu.Net.BenchJsonWriter [반복 횟수]
+ */
+class PROJECT_PKNU_API FPknuJsonWriter
+{
+public:
+    // 루트 객체 시작 (이전 출력은 버림)
+    void BeginObject();
+    // Key 를 가진 하위 객체 시작
+    void BeginObject(const TCHAR* Key);
+    void EndObject();
+
+    void WriteString(const TCHAR* Key, const FString& Value);
+    void WriteString(const TCHAR* Key, const TCHAR* Value);
+    void WriteNumber(const TCHAR* Key, double Value);
+    void WriteBool(const TCHAR* Key, bool bValue);
+
+    // 루트 객체를 닫은 뒤의 결과
+    const FString& GetOutput() const { return Buffer; }
+
+private:
+    enum class EToken : uint8
+    {
+        None,
+        CurlyOpen,
+        CurlyClose,
+        Value,
+    };
+
+    void WriteIdentifier(const TCHAR* Key);
+    void WriteCommaIfNeeded();
+    void WriteLineTerminatorAndTabs();
+    void AppendEscaped(const TCHAR* Str, int32 Len);
+
+    FString Buffer;
+    int32 IndentLevel = 0;
+    EToken PreviousToken = EToken::None;
+};
@@ -0,0 +1,132 @@
+#include "RemoteAvatarPool.h"
+#include "MyRemoteCharacter.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarPoolWarmSize(
+    TEXT("Pknu.Avatar.Pool.WarmSize"),
+    8,
+    TEXT("미리 스폰해 숨겨 둘 원격 캐릭터 수. 0 이면 풀이 빌 때만 스폰."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarPoolSpawnsPerFrame(
+    TEXT("Pknu.Avatar.Pool.SpawnsPerFrame"),
+    1,
+    TEXT("대기 액터를 목표 수까지 채울 때 프레임당 스폰하는 최대 수 (스폰 비용을 여러 프레임에 분산)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarPoolGrowStep(
+    TEXT("Pknu.Avatar.Pool.GrowStep"),
+    4,
+    TEXT("풀이 빈 상태에서 꺼낼 때마다 대기 목표 수를 늘리는 양. 0 이면 WarmSize 고정."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarPoolMaxIdle(
+    TEXT("Pknu.Avatar.Pool.MaxIdle"),
+    64,
+    TEXT("풀에 남겨 둘 대기 액터 최대 수. 이보다 많이 반납되면 파괴."),
+    ECVF_Default);
+
+void URemoteAvatarPool::Deinitialize()
+{
+    // 액터는 월드와 함께 정리됨
+    IdleAvatars.Empty();
+    AvatarClass = nullptr;
+    TargetIdle = 0;
+
+    Super::Deinitialize();
+}
+
+bool URemoteAvatarPool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URemoteAvatarPool::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URemoteAvatarPool, STATGROUP_Tickables);
+}
+
+void URemoteAvatarPool::SetAvatarClass(TSubclassOf<AMyRemoteCharacter> InAvatarClass)
+{
+    if (AvatarClass == InAvatarClass) return;
+
+    for (AMyRemoteCharacter* Avatar : IdleAvatars)
+    {
+        if (IsValid(Avatar))
+        {
+            Avatar->Destroy();
+        }
+    }
+    IdleAvatars.Reset();
+
+    AvatarClass = InAvatarClass;
+    TargetIdle = FMath::Max(CVarPknuAvatarPoolWarmSize.GetValueOnGameThread(), 0);
+}
+
+void URemoteAvatarPool::Tick(float DeltaTime)
+{
+    if (!AvatarClass) return;
+
+    const int32 MaxIdle = FMath::Max(CVarPknuAvatarPoolMaxIdle.GetValueOnGameThread(), 0);
+    TargetIdle = FMath::Clamp(TargetIdle, FMath::Max(CVarPknuAvatarPoolWarmSize.GetValueOnGameThread(), 0), MaxIdle);
+
+    int32 Budget = FMath::Max(CVarPknuAvatarPoolSpawnsPerFrame.GetValueOnGameThread(), 1);
+    while (IdleAvatars.Num() < TargetIdle && Budget-- > 0)
+    {
+        AMyRemoteCharacter* Avatar = SpawnIdleAvatar();
+        if (!Avatar) break;
+        IdleAvatars.Add(Avatar);
+    }
+}
+
+AMyRemoteCharacter* URemoteAvatarPool::SpawnIdleAvatar()
+{
+    UWorld* World = GetWorld();
+    if (!World || !AvatarClass) return nullptr;
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    AMyRemoteCharacter* Avatar = World->SpawnActor<AMyRemoteCharacter>(AvatarClass, FTransform::Identity, Params);
+    if (Avatar)
+    {
+        Avatar->DeactivateForPool();
+    }
+    return Avatar;
+}
+
+AMyRemoteCharacter* URemoteAvatarPool::Acquire(const FTransform& Transform)
+{
+    AMyRemoteCharacter* Avatar = nullptr;
+    while (!Avatar && IdleAvatars.Num() > 0)
+    {
+        Avatar = IdleAvatars.Pop(EAllowShrinking::No);
+        if (!IsValid(Avatar)) Avatar = nullptr; // 레벨 전환 등으로 이미 파괴됨
+    }
+
+    if (!Avatar)
+    {
+        // 대기 액터가 모자람: 이번 것은 바로 스폰하고, 다음부터는 더 많이 채워 둠
+        TargetIdle += FMath::Max(CVarPknuAvatarPoolGrowStep.GetValueOnGameThread(), 0);
+        Avatar = SpawnIdleAvatar();
+        if (!Avatar) return nullptr;
+    }
+
+    Avatar->ActivateFromPool(Transform);
+    return Avatar;
+}
+
+void URemoteAvatarPool::Release(AMyRemoteCharacter* Avatar)
+{
+    if (!IsValid(Avatar)) return;
+
+    if (Avatar->GetClass() != AvatarClass || IdleAvatars.Num() >= FMath::Max(CVarPknuAvatarPoolMaxIdle.GetValueOnGameThread(), 0))
+    {
+        Avatar->Destroy();
+        return;
+    }
+
+    Avatar->DeactivateForPool();
+    IdleAvatars.Add(Avatar);
+}
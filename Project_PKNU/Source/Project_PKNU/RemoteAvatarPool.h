@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "RemoteAvatarPool.generated.h"
+
+class AMyRemoteCharacter;
+
+/**
+ * 원격 캐릭터 액터 풀.
+ *
+ * add_character / remove_character 마다 SpawnActor / Destroy 를 하면 붐비는 로비에서 스폰 히치와 GC 스파이크가 생기므로,
+ * 숨겨 둔 AMyRemoteCharacter 를 미리 만들어 두고 꺼내 쓴 뒤 반납받아 재사용한다.
+ * 반납된 액터는 아바타 서브시스템에서 등록이 해제되고(스냅샷 버퍼 초기화) 숨김 / 충돌 / Tick 이 꺼진 상태로 대기한다.
+ *
+ * 대기 액터 수는 Pknu.Avatar.Pool.WarmSize 를 목표로 프레임당 Pknu.Avatar.Pool.SpawnsPerFrame 개씩 채운다.
+ * 풀이 비어 있을 때 꺼내면 그 자리에서 스폰하고 목표를 Pknu.Avatar.Pool.GrowStep 만큼 늘린다 (Pknu.Avatar.Pool.MaxIdle 까지).
+ * MaxIdle 을 넘게 반납되는 액터는 파괴한다.
+ */
+UCLASS()
+class PROJECT_PKNU_API URemoteAvatarPool : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // 풀에 담을 클래스. 바뀌면 기존 대기 액터는 파괴
+    void SetAvatarClass(TSubclassOf<AMyRemoteCharacter> InAvatarClass);
+
+    // 대기 액터를 꺼내 Transform 위치에 활성화 (없으면 스폰). 클래스가 없으면 nullptr
+    AMyRemoteCharacter* Acquire(const FTransform& Transform);
+    void Release(AMyRemoteCharacter* Avatar);
+
+    int32 NumIdle() const { return IdleAvatars.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    AMyRemoteCharacter* SpawnIdleAvatar();
+
+    UPROPERTY()
+    TSubclassOf<AMyRemoteCharacter> AvatarClass;
+
+    UPROPERTY()
+    TArray<TObjectPtr<AMyRemoteCharacter>> IdleAvatars;
+
+    // 채워 둘 대기 액터 수 (WarmSize 에서 시작해 풀이 비면 늘어남)
+    int32 TargetIdle = 0;
+};
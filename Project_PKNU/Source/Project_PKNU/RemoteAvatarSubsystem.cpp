@@ -0,0 +1,719 @@
+#include "RemoteAvatarSubsystem.h"
+#include "MyRemoteCharacter.h"
+#include "PknuClockSync.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarSnapshotCapacity(
+    TEXT("Pknu.Avatar.SnapshotCapacity"),
+    64,
+    TEXT("원격 캐릭터 하나당 스냅샷 링 용량 (2의 거듭제곱으로 올림). 월드 시작 시 적용."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarParallelThreshold(
+    TEXT("Pknu.Avatar.ParallelThreshold"),
+    64,
+    TEXT("원격 캐릭터가 이 수 이상이면 보간을 ParallelFor 로 나눠 실행. 0 이면 항상 게임 스레드에서 실행."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarPknuAvatarAdaptiveDelay(
+    TEXT("Pknu.Avatar.AdaptiveDelay"),
+    true,
+    TEXT("업데이트 도착 간격의 지터로 원격 캐릭터 보간 지연을 자동 조절. false 면 캐릭터의 InterpolationDelay 고정."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarMinDelay(
+    TEXT("Pknu.Avatar.MinDelay"),
+    0.05f,
+    TEXT("자동 보간 지연의 하한 (초)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarMaxDelay(
+    TEXT("Pknu.Avatar.MaxDelay"),
+    0.5f,
+    TEXT("자동 보간 지연의 상한 (초)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarJitterDeviations(
+    TEXT("Pknu.Avatar.JitterDeviations"),
+    4.f,
+    TEXT("목표 지연 = 평균 전송 시간 + 평균 도착 간격 + 이 값 x 도착 간격 편차."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarMaxExtrapolation(
+    TEXT("Pknu.Avatar.MaxExtrapolation"),
+    0.25f,
+    TEXT("스냅샷이 끊겼을 때 마지막 스냅샷 이후로 외삽하는 최대 시간 (초). 0 이면 마지막 위치에서 멈춤."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarConvergenceTime(
+    TEXT("Pknu.Avatar.ConvergenceTime"),
+    0.1f,
+    TEXT("외삽 위치와 새로 받은 실제 위치의 차이를 줄이는 시간 상수 (초). 0 이면 바로 이동."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarPknuAvatarSignificanceEnabled(
+    TEXT("Pknu.Avatar.Significance.Enabled"),
+    true,
+    TEXT("카메라 거리 / 화면 노출로 원격 캐릭터의 보간 / 애니메이션 / 이름표 갱신 주기를 낮춤. false 면 모두 High."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPknuAvatarSignificanceHighBudget(
+    TEXT("Pknu.Avatar.Significance.HighBudget"),
+    16,
+    TEXT("High 등급(매 프레임 갱신)으로 둘 원격 캐릭터 최대 수. 가까운 순으로 채우고 나머지는 Medium."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarSignificanceNearDistance(
+    TEXT("Pknu.Avatar.Significance.NearDistance"),
+    2500.f,
+    TEXT("이 거리(cm) 안에서 보이는 원격 캐릭터만 High 후보."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarSignificanceFarDistance(
+    TEXT("Pknu.Avatar.Significance.FarDistance"),
+    8000.f,
+    TEXT("이 거리(cm)보다 멀거나 최근 렌더되지 않은 원격 캐릭터는 Low."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarSignificanceMediumInterval(
+    TEXT("Pknu.Avatar.Significance.MediumInterval"),
+    1.f / 30.f,
+    TEXT("Medium 등급의 보간 / 애니메이션 / 이름표 갱신 주기 (초)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPknuAvatarSignificanceLowInterval(
+    TEXT("Pknu.Avatar.Significance.LowInterval"),
+    0.1f,
+    TEXT("Low 등급의 보간 / 애니메이션 갱신 주기 (초)."),
+    ECVF_Default);
+
+namespace
+{
+    // 이보다 오래된 스냅샷은 보간에 쓰이지 않으므로 버림
+    constexpr double SnapshotRetentionSeconds = 2.0;
+
+    // 도착 간격 평균 / 편차 갱신 비율 (TCP SRTT / RTTVAR 와 같은 1/8, 1/4)
+    constexpr float IntervalMeanGain = 1.f / 8.f;
+    constexpr float IntervalDeviationGain = 1.f / 4.f;
+
+    // 이보다 긴 간격은 지터가 아니라 정지(서버는 바뀐 엔티티만 보냄)로 보고 샘플에서 제외
+    constexpr double IdleGapSeconds = 1.0;
+
+    // 지연 변경 속도 (초당). 1 보다 작아야 렌더 시간이 되감기지 않음
+    constexpr float DelaySlewRate = 0.25f;
+
+    // 스냅샷 속도(보간 접선 / 외삽)는 보낸 speed 의 이 배수까지만 허용 (양자화 오차, 스냅샷 간격 흔들림 여유)
+    constexpr float VelocitySpeedTolerance = 1.25f;
+
+    // 이보다 짧은 스냅샷 간격으로는 속도를 구하지 않음
+    constexpr double MinVelocitySampleSeconds = 0.001;
+
+    // 외삽 오차가 이보다 크면 (순간이동, 리스폰) 수렴 없이 바로 이동
+    constexpr float MaxConvergenceDistance = 300.f;
+
+    // 중요도 재계산 주기 (초). 등급 변경은 컴포넌트 설정을 바꾸므로 매 프레임 하지 않음
+    constexpr double SignificanceUpdateInterval = 0.25;
+    // WasRecentlyRendered 판정 시간
+    constexpr float RecentlyRenderedSeconds = 0.25f;
+    // 화면 밖 아바타의 정렬 점수 배율 (거리 제곱 기준, 4 = 두 배 먼 것으로 취급)
+    constexpr float OffscreenScoreScale = 4.f;
+    // 주기가 긴 등급에서 한 번에 처리할 경과 시간 상한 (지연 / 수렴 계산용)
+    constexpr float MaxAvatarDeltaTime = 0.25f;
+}
+
+void URemoteAvatarSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    SnapshotCapacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(CVarPknuAvatarSnapshotCapacity.GetValueOnGameThread(), 4))));
+    SnapshotMask = SnapshotCapacity - 1;
+}
+
+void URemoteAvatarSubsystem::Deinitialize()
+{
+    for (const TWeakObjectPtr<AMyRemoteCharacter>& Actor : Actors)
+    {
+        if (Actor.IsValid())
+        {
+            Actor->AvatarIndex = INDEX_NONE;
+        }
+    }
+    Actors.Empty();
+    InterpolationDelays.Empty();
+    TargetDelays.Empty();
+    LastArrivalTimes.Empty();
+    MeanArrivalIntervals.Empty();
+    ArrivalIntervalDeviations.Empty();
+    MeanTransitTimes.Empty();
+    RingHeads.Empty();
+    RingCounts.Empty();
+    Cursors.Empty();
+    LastFallingFlags.Empty();
+    SnapshotSerials.Empty();
+    SeenSerials.Empty();
+    BlendOffsets.Empty();
+    BlendRotations.Empty();
+    Significances.Empty();
+    UpdateIntervals.Empty();
+    LastInterpolationTimes.Empty();
+    PendingPoses.Empty();
+    SignificanceScores.Empty();
+    SignificanceOrder.Empty();
+    NextSignificanceUpdateTime = 0.0;
+    OutModes.Empty();
+    OutLocations.Empty();
+    OutRotations.Empty();
+    SnapshotTimes.Empty();
+    SnapshotTransforms.Empty();
+    SnapshotSpeeds.Empty();
+
+    Super::Deinitialize();
+}
+
+bool URemoteAvatarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URemoteAvatarSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URemoteAvatarSubsystem, STATGROUP_Tickables);
+}
+
+int32 URemoteAvatarSubsystem::RegisterAvatar(AMyRemoteCharacter* Actor, float InitialDelay)
+{
+    check(Actor);
+
+    const int32 AvatarIndex = Actors.Add(Actor);
+    InterpolationDelays.Add(InitialDelay);
+    TargetDelays.Add(InitialDelay);
+    LastArrivalTimes.Add(0.0);
+    MeanArrivalIntervals.Add(0.f);
+    ArrivalIntervalDeviations.Add(0.f);
+    MeanTransitTimes.Add(0.f);
+    RingHeads.Add(0);
+    RingCounts.Add(0);
+    Cursors.Add(0);
+    LastFallingFlags.Add(false);
+    SnapshotSerials.Add(0);
+    SeenSerials.Add(0);
+    BlendOffsets.Add(FVector::ZeroVector);
+    BlendRotations.Add(FQuat::Identity);
+    Significances.Add(ERemoteAvatarSignificance::High);
+    UpdateIntervals.Add(0.f);
+    LastInterpolationTimes.Add(0.0);
+    PendingPoses.Add(false);
+    OutModes.Add(EAvatarOutput::None);
+    OutLocations.Add(FVector::ZeroVector);
+    OutRotations.Add(FQuat::Identity);
+
+    // 아바타 하나분의 스냅샷 칸을 미리 확보 (이후 스냅샷 추가는 재할당 없음)
+    SnapshotTimes.AddZeroed(SnapshotCapacity);
+    SnapshotTransforms.AddDefaulted(SnapshotCapacity);
+    SnapshotSpeeds.AddZeroed(SnapshotCapacity);
+    return AvatarIndex;
+}
+
+void URemoteAvatarSubsystem::UnregisterAvatar(int32 AvatarIndex)
+{
+    if (!Actors.IsValidIndex(AvatarIndex)) return;
+
+    // 마지막 아바타를 빈자리로 옮겨 배열을 조밀하게 유지
+    const int32 LastIndex = Actors.Num() - 1;
+    if (AvatarIndex != LastIndex)
+    {
+        FMemory::Memcpy(&SnapshotTimes[AvatarIndex * SnapshotCapacity], &SnapshotTimes[LastIndex * SnapshotCapacity], sizeof(double) * SnapshotCapacity);
+        FMemory::Memcpy(&SnapshotSpeeds[AvatarIndex * SnapshotCapacity], &SnapshotSpeeds[LastIndex * SnapshotCapacity], sizeof(float) * SnapshotCapacity);
+        for (int32 i = 0; i < SnapshotCapacity; ++i)
+        {
+            SnapshotTransforms[AvatarIndex * SnapshotCapacity + i] = SnapshotTransforms[LastIndex * SnapshotCapacity + i];
+        }
+        if (AMyRemoteCharacter* Moved = Actors[LastIndex].Get())
+        {
+            Moved->AvatarIndex = AvatarIndex;
+        }
+    }
+
+    Actors.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    InterpolationDelays.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    TargetDelays.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    LastArrivalTimes.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    MeanArrivalIntervals.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    ArrivalIntervalDeviations.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    MeanTransitTimes.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    RingHeads.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    RingCounts.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    Cursors.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    LastFallingFlags.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    SnapshotSerials.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    SeenSerials.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    BlendOffsets.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    BlendRotations.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    Significances.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    UpdateIntervals.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    LastInterpolationTimes.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    PendingPoses.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    OutModes.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    OutLocations.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    OutRotations.RemoveAtSwap(AvatarIndex, EAllowShrinking::No);
+    SnapshotTimes.SetNum(LastIndex * SnapshotCapacity, EAllowShrinking::No);
+    SnapshotTransforms.SetNum(LastIndex * SnapshotCapacity, EAllowShrinking::No);
+    SnapshotSpeeds.SetNum(LastIndex * SnapshotCapacity, EAllowShrinking::No);
+}
+
+void URemoteAvatarSubsystem::AddSnapshot(int32 AvatarIndex, const FVector& Location, const FQuat& Rotation, float Speed, bool bIsFalling, double Timestamp)
+{
+    if (!Actors.IsValidIndex(AvatarIndex)) return;
+
+    const double Now = FPknuClockSync::LocalNow();
+    UpdateJitterEstimate(AvatarIndex, Now, Timestamp);
+
+    // 오래된 데이터 정리 (앞에서부터만 보면 됨, 가장 최근 스냅샷은 정지 자세로 남음)
+    PopSnapshotsOlderThan(AvatarIndex, Now - SnapshotRetentionSeconds);
+
+    // 정지 후 다시 움직이기 시작한 경우: 송신 쪽은 바뀔 때만 보내므로 남아 있는 정지 자세는 오래전 시각이지만
+    // 실제로는 이번 스냅샷의 한 송신 주기 전까지 그 자리에 있었음. 시각을 그대로 두면 보간 비율이 처음부터 거의 1 이라
+    // 새 위치로 튀므로, 정지 자세를 한 송신 주기 전으로 옮겨 그 구간을 보간
+    const int32 Count = RingCounts[AvatarIndex];
+    if (Count > 0)
+    {
+        const int32 LastSlot = SnapshotSlot(AvatarIndex, Count - 1);
+        if (Timestamp - SnapshotTimes[LastSlot] > IdleGapSeconds)
+        {
+            const float MeanInterval = MeanArrivalIntervals[AvatarIndex];
+            SnapshotTimes[LastSlot] = Timestamp - (MeanInterval > 0.f ? MeanInterval : SenderInterval);
+        }
+    }
+
+    // 타임스탬프 순서 자리에 삽입
+    // (서버에서 순서대로 보내므로 보통은 끝에 붙고, 네트워크 지연으로 순서가 바뀐 것만 제자리를 찾아 들어감)
+    InsertSnapshot(AvatarIndex, Timestamp, Quantizer.Quantize(Location, Rotation), Speed);
+
+    LastFallingFlags[AvatarIndex] = bIsFalling;
+    ++SnapshotSerials[AvatarIndex];
+}
+
+void URemoteAvatarSubsystem::SetQuantizer(const FTransformQuantizer& InQuantizer)
+{
+    if (Quantizer == InQuantizer) return;
+
+    for (int32 AvatarIndex = 0; AvatarIndex < Actors.Num(); ++AvatarIndex)
+    {
+        for (int32 i = 0; i < RingCounts[AvatarIndex]; ++i)
+        {
+            FQuantizedTransform& Transform = SnapshotTransforms[SnapshotSlot(AvatarIndex, i)];
+            Transform = InQuantizer.Quantize(Quantizer.DequantizeLocation(Transform), Quantizer.DequantizeRotation(Transform));
+        }
+    }
+    Quantizer = InQuantizer;
+}
+
+void URemoteAvatarSubsystem::UpdateJitterEstimate(int32 AvatarIndex, double ArrivalTime, double Timestamp)
+{
+    // 전송 시간은 간격 샘플과 별개로 매번 갱신 (첫 샘플은 그대로 채택)
+    const float Transit = static_cast<float>(FMath::Max(ArrivalTime - Timestamp, 0.0));
+    float& MeanTransit = MeanTransitTimes[AvatarIndex];
+    MeanTransit = LastArrivalTimes[AvatarIndex] <= 0.0 ? Transit : MeanTransit + (Transit - MeanTransit) * IntervalMeanGain;
+
+    const double LastArrival = LastArrivalTimes[AvatarIndex];
+    LastArrivalTimes[AvatarIndex] = ArrivalTime;
+    if (LastArrival <= 0.0) return;
+
+    const double Interval = ArrivalTime - LastArrival;
+    if (Interval <= 0.0 || Interval > IdleGapSeconds) return;
+
+    float& Mean = MeanArrivalIntervals[AvatarIndex];
+    float& Deviation = ArrivalIntervalDeviations[AvatarIndex];
+    const float Sample = static_cast<float>(Interval);
+    if (Mean <= 0.f)
+    {
+        Mean = Sample;
+        Deviation = Sample * 0.5f;
+    }
+    else
+    {
+        // 편차는 갱신 전 평균 기준 (Jacobson / Karels)
+        Deviation += (FMath::Abs(Sample - Mean) - Deviation) * IntervalDeviationGain;
+        Mean += (Sample - Mean) * IntervalMeanGain;
+    }
+
+    // 다음 스냅샷이 늦게 와도 보간할 구간이 남아 있도록
+    const float MinDelay = CVarPknuAvatarMinDelay.GetValueOnGameThread();
+    const float MaxDelay = FMath::Max(CVarPknuAvatarMaxDelay.GetValueOnGameThread(), MinDelay);
+    TargetDelays[AvatarIndex] = FMath::Clamp(MeanTransit + Mean + CVarPknuAvatarJitterDeviations.GetValueOnGameThread() * Deviation, MinDelay, MaxDelay);
+}
+
+void URemoteAvatarSubsystem::SlewInterpolationDelay(int32 AvatarIndex, float DeltaTime)
+{
+    float& Delay = InterpolationDelays[AvatarIndex];
+    const float MaxStep = DelaySlewRate * DeltaTime;
+    Delay += FMath::Clamp(TargetDelays[AvatarIndex] - Delay, -MaxStep, MaxStep);
+}
+
+void URemoteAvatarSubsystem::InsertSnapshot(int32 AvatarIndex, double Timestamp, const FQuantizedTransform& Transform, float Speed)
+{
+    int32& Count = RingCounts[AvatarIndex];
+    int32& Cursor = Cursors[AvatarIndex];
+
+    // 같은 시각은 나중에 온 것을 뒤에 둠
+    int32 InsertAt = Count;
+    while (InsertAt > 0 && Timestamp < SnapshotTimes[SnapshotSlot(AvatarIndex, InsertAt - 1)])
+    {
+        --InsertAt;
+    }
+
+    if (Count == SnapshotCapacity)
+    {
+        // 가득 참: 가장 오래된 것보다 더 오래된 스냅샷은 버리고, 아니면 가장 오래된 스냅샷을 밀어냄
+        if (InsertAt == 0) return;
+        RingHeads[AvatarIndex] = (RingHeads[AvatarIndex] + 1) & SnapshotMask;
+        --Count;
+        --InsertAt;
+        --Cursor;
+    }
+
+    // InsertAt 뒤의 스냅샷을 한 칸씩 밀고 그 자리에 기록 (순서대로 도착하면 이동 없음)
+    for (int32 i = Count; i > InsertAt; --i)
+    {
+        const int32 Dst = SnapshotSlot(AvatarIndex, i);
+        const int32 Src = SnapshotSlot(AvatarIndex, i - 1);
+        SnapshotTimes[Dst] = SnapshotTimes[Src];
+        SnapshotTransforms[Dst] = SnapshotTransforms[Src];
+        SnapshotSpeeds[Dst] = SnapshotSpeeds[Src];
+    }
+    const int32 Slot = SnapshotSlot(AvatarIndex, InsertAt);
+    SnapshotTimes[Slot] = Timestamp;
+    SnapshotTransforms[Slot] = Transform;
+    SnapshotSpeeds[Slot] = Speed;
+    ++Count;
+
+    // 커서는 힌트일 뿐이지만 가능한 한 같은 스냅샷을 가리키도록 보정
+    if (InsertAt <= Cursor)
+    {
+        ++Cursor;
+    }
+}
+
+void URemoteAvatarSubsystem::PopSnapshotsOlderThan(int32 AvatarIndex, double Time)
+{
+    // 가장 최근 스냅샷은 남김 (정지한 동안 새 스냅샷이 없으므로, 다 버리면 다음 스냅샷이 보간할 시작점이 없음)
+    int32 NumToPop = 0;
+    while (NumToPop + 1 < RingCounts[AvatarIndex] && SnapshotTimes[SnapshotSlot(AvatarIndex, NumToPop)] < Time)
+    {
+        ++NumToPop;
+    }
+    RingHeads[AvatarIndex] = (RingHeads[AvatarIndex] + NumToPop) & SnapshotMask;
+    RingCounts[AvatarIndex] -= NumToPop;
+    Cursors[AvatarIndex] -= NumToPop;
+}
+
+int32 URemoteAvatarSubsystem::FindLastSnapshotAtOrBefore(int32 AvatarIndex, double Time) const
+{
+    int32 Low = 0;
+    int32 High = RingCounts[AvatarIndex]; // [Low, High) 에서 Timestamp > Time 인 첫 위치를 찾음
+    while (Low < High)
+    {
+        const int32 Mid = Low + (High - Low) / 2;
+        if (SnapshotTimes[SnapshotSlot(AvatarIndex, Mid)] <= Time)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+    return Low - 1;
+}
+
+int32 URemoteAvatarSubsystem::FindInterpolationIndex(int32 AvatarIndex, double RenderTime)
+{
+    // 커서에서 이만큼 넘게 전진해야 하면 (프레임 멈춤, 큰 DeltaTime) 이진 탐색이 더 쌈
+    constexpr int32 MaxCursorSteps = 4;
+
+    const int32 NumSnapshots = RingCounts[AvatarIndex];
+    int32 Cursor = FMath::Clamp(Cursors[AvatarIndex], 0, NumSnapshots - 1);
+
+    if (SnapshotTimes[SnapshotSlot(AvatarIndex, Cursor)] <= RenderTime)
+    {
+        int32 Steps = 0;
+        while (Cursor + 1 < NumSnapshots && SnapshotTimes[SnapshotSlot(AvatarIndex, Cursor + 1)] <= RenderTime && Steps < MaxCursorSteps)
+        {
+            ++Cursor;
+            ++Steps;
+        }
+        if (Cursor + 1 < NumSnapshots && SnapshotTimes[SnapshotSlot(AvatarIndex, Cursor + 1)] <= RenderTime)
+        {
+            Cursor = FindLastSnapshotAtOrBefore(AvatarIndex, RenderTime);
+        }
+    }
+    else
+    {
+        // 시간이 뒤로 튐 (또는 커서보다 오래된 스냅샷이 늦게 도착)
+        Cursor = FindLastSnapshotAtOrBefore(AvatarIndex, RenderTime);
+    }
+
+    Cursors[AvatarIndex] = FMath::Max(Cursor, 0);
+    return Cursor;
+}
+
+FVector URemoteAvatarSubsystem::SnapshotVelocity(int32 AvatarIndex, int32 Index) const
+{
+    const int32 Slot = SnapshotSlot(AvatarIndex, Index);
+    const float Speed = SnapshotSpeeds[Slot];
+    // 서 있다고 보고된 스냅샷은 움직이지 않음 (멈출 때 곡선이 지나쳤다 돌아오지 않도록)
+    if (Speed <= KINDA_SMALL_NUMBER) return FVector::ZeroVector;
+
+    // 앞뒤 스냅샷의 차분 (끝에서는 한쪽만)
+    const int32 PrevSlot = SnapshotSlot(AvatarIndex, FMath::Max(Index - 1, 0));
+    const int32 NextSlot = SnapshotSlot(AvatarIndex, FMath::Min(Index + 1, RingCounts[AvatarIndex] - 1));
+    const double SampleTime = SnapshotTimes[NextSlot] - SnapshotTimes[PrevSlot];
+    if (SampleTime <= MinVelocitySampleSeconds) return FVector::ZeroVector;
+
+    const FVector Velocity = (Quantizer.DequantizeLocation(SnapshotTransforms[NextSlot]) - Quantizer.DequantizeLocation(SnapshotTransforms[PrevSlot])) / static_cast<float>(SampleTime);
+    return Velocity.GetClampedToMaxSize(Speed * VelocitySpeedTolerance);
+}
+
+FVector URemoteAvatarSubsystem::ExtrapolateLocation(int32 AvatarIndex, float Ahead, float GravityZ) const
+{
+    const int32 LastIndex = RingCounts[AvatarIndex] - 1;
+    const FVector LastLocation = Quantizer.DequantizeLocation(SnapshotTransforms[SnapshotSlot(AvatarIndex, LastIndex)]);
+    if (LastIndex < 1 || Ahead <= 0.f) return LastLocation;
+
+    // Hermite 보간의 끝 접선과 같은 속도라서 보간 -> 외삽 경계에서 꺾이지 않음
+    FVector Location = LastLocation + SnapshotVelocity(AvatarIndex, LastIndex) * Ahead;
+    if (LastFallingFlags[AvatarIndex])
+    {
+        // 공중이면 포물선 (GravityZ 는 음수)
+        Location.Z += 0.5f * GravityZ * Ahead * Ahead;
+    }
+    return Location;
+}
+
+URemoteAvatarSubsystem::EAvatarOutput URemoteAvatarSubsystem::EvaluateAvatar(int32 AvatarIndex, const FAvatarFrameParams& Frame, FVector& OutLocation, FQuat& OutRotation)
+{
+    const int32 NumSnapshots = RingCounts[AvatarIndex];
+    if (NumSnapshots == 0) return EAvatarOutput::None;
+
+    if (NumSnapshots == 1)
+    {
+        // 데이터가 하나뿐이면 해당 위치로 이동
+        const FQuantizedTransform& Only = SnapshotTransforms[SnapshotSlot(AvatarIndex, 0)];
+        OutLocation = Quantizer.DequantizeLocation(Only);
+        OutRotation = Quantizer.DequantizeRotation(Only);
+        return EAvatarOutput::Pose;
+    }
+
+    // 보간의 기준이 될 과거 시간 (로컬 클라이언트 시간 기준)
+    const double RenderTime = Frame.Now - InterpolationDelays[AvatarIndex];
+
+    const int32 FromIndex = FindInterpolationIndex(AvatarIndex, RenderTime);
+    if (FromIndex != INDEX_NONE && FromIndex + 1 < NumSnapshots)
+    {
+        const int32 FromSlot = SnapshotSlot(AvatarIndex, FromIndex);
+        const int32 ToSlot = SnapshotSlot(AvatarIndex, FromIndex + 1);
+        const double FromTime = SnapshotTimes[FromSlot];
+        const double TimeBetweenSnapshots = SnapshotTimes[ToSlot] - FromTime;
+        // 두 스냅샷 사이에서 RenderTime이 얼마나 진행되었는지 비율 계산 (0.0 ~ 1.0)
+        const float InterpAlpha = (TimeBetweenSnapshots > 0.0) ? (float)((RenderTime - FromTime) / TimeBetweenSnapshots) : 0.0f;
+
+        // 위치는 양 끝 속도를 접선으로 하는 3차 Hermite, 회전은 slerp
+        // (CubicInterp 의 접선은 구간 길이로 정규화된 값이므로 속도 x 구간 시간)
+        const FQuantizedTransform& From = SnapshotTransforms[FromSlot];
+        const FQuantizedTransform& To = SnapshotTransforms[ToSlot];
+        const float Span = static_cast<float>(TimeBetweenSnapshots);
+        OutLocation = FMath::CubicInterp(
+            Quantizer.DequantizeLocation(From), SnapshotVelocity(AvatarIndex, FromIndex) * Span,
+            Quantizer.DequantizeLocation(To), SnapshotVelocity(AvatarIndex, FromIndex + 1) * Span,
+            InterpAlpha);
+        OutRotation = FQuat::Slerp(Quantizer.DequantizeRotation(From), Quantizer.DequantizeRotation(To), InterpAlpha);
+        return EAvatarOutput::Pose;
+    }
+
+    const int32 LastSlot = SnapshotSlot(AvatarIndex, NumSnapshots - 1);
+    const double LastTime = SnapshotTimes[LastSlot];
+    if (RenderTime > LastTime)
+    {
+        // RenderTime이 버퍼의 모든 스냅샷보다 최신 (다음 스냅샷이 늦음)
+        // 마지막 스냅샷에서 MaxExtrapolation 까지만 추정하고, 그 뒤로는 멈춰서 새 데이터를 기다림
+        const float Ahead = static_cast<float>(FMath::Min(RenderTime - LastTime, static_cast<double>(Frame.MaxExtrapolation)));
+        OutLocation = ExtrapolateLocation(AvatarIndex, Ahead, Frame.GravityZ);
+        OutRotation = Quantizer.DequantizeRotation(SnapshotTransforms[LastSlot]);
+        return Ahead > 0.f ? EAvatarOutput::Extrapolated : EAvatarOutput::Pose;
+    }
+
+    return EAvatarOutput::None;
+}
+
+void URemoteAvatarSubsystem::UpdateSignificance()
+{
+    const int32 Num = Actors.Num();
+
+    FVector ViewLocation = FVector::ZeroVector;
+    FRotator ViewRotation = FRotator::ZeroRotator;
+    APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+    const bool bEnabled = CVarPknuAvatarSignificanceEnabled.GetValueOnGameThread() && PlayerController;
+    if (bEnabled)
+    {
+        PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    }
+
+    const float NearDistanceSquared = FMath::Square(CVarPknuAvatarSignificanceNearDistance.GetValueOnGameThread());
+    const float FarDistanceSquared = FMath::Square(CVarPknuAvatarSignificanceFarDistance.GetValueOnGameThread());
+    const float Intervals[] =
+    {
+        0.f,
+        FMath::Max(CVarPknuAvatarSignificanceMediumInterval.GetValueOnGameThread(), 0.f),
+        FMath::Max(CVarPknuAvatarSignificanceLowInterval.GetValueOnGameThread(), 0.f),
+    };
+
+    // 1) 거리 / 노출로 점수와 예산 적용 전 등급 (High 는 아직 후보)
+    SignificanceScores.SetNumUninitialized(Num, EAllowShrinking::No);
+    SignificanceOrder.Reset();
+    TArray<ERemoteAvatarSignificance, TInlineAllocator<256>> Candidates;
+    Candidates.SetNumUninitialized(Num);
+    for (int32 AvatarIndex = 0; AvatarIndex < Num; ++AvatarIndex)
+    {
+        const AMyRemoteCharacter* Actor = Actors[AvatarIndex].Get();
+        if (!bEnabled || !Actor)
+        {
+            SignificanceScores[AvatarIndex] = 0.f;
+            Candidates[AvatarIndex] = ERemoteAvatarSignificance::High;
+            SignificanceOrder.Add(AvatarIndex);
+            continue;
+        }
+
+        const float DistanceSquared = FVector::DistSquared(ViewLocation, Actor->GetActorLocation());
+        const bool bVisible = Actor->WasRecentlyRendered(RecentlyRenderedSeconds);
+        SignificanceScores[AvatarIndex] = bVisible ? DistanceSquared : DistanceSquared * OffscreenScoreScale;
+        Candidates[AvatarIndex] = (!bVisible || DistanceSquared > FarDistanceSquared) ? ERemoteAvatarSignificance::Low
+            : (DistanceSquared <= NearDistanceSquared ? ERemoteAvatarSignificance::High : ERemoteAvatarSignificance::Medium);
+        SignificanceOrder.Add(AvatarIndex);
+    }
+
+    // 2) 가까운 순으로 High 예산을 채움 (비활성이면 예산 없이 모두 High)
+    SignificanceOrder.Sort([this](int32 A, int32 B) { return SignificanceScores[A] < SignificanceScores[B]; });
+
+    const int32 HighBudget = bEnabled ? FMath::Max(CVarPknuAvatarSignificanceHighBudget.GetValueOnGameThread(), 0) : Num;
+    int32 NumHigh = 0;
+    for (const int32 AvatarIndex : SignificanceOrder)
+    {
+        ERemoteAvatarSignificance Significance = Candidates[AvatarIndex];
+        if (Significance == ERemoteAvatarSignificance::High && NumHigh++ >= HighBudget)
+        {
+            Significance = ERemoteAvatarSignificance::Medium;
+        }
+
+        const float Interval = Intervals[static_cast<int32>(Significance)];
+        UpdateIntervals[AvatarIndex] = Interval;
+        if (Significances[AvatarIndex] == Significance) continue;
+
+        Significances[AvatarIndex] = Significance;
+        if (AMyRemoteCharacter* Actor = Actors[AvatarIndex].Get())
+        {
+            Actor->SetSignificance(Significance, Interval);
+        }
+    }
+}
+
+void URemoteAvatarSubsystem::InterpolateAvatar(int32 AvatarIndex, const FAvatarFrameParams& Frame)
+{
+    // 등급별 주기. 건너뛴 프레임의 시간은 다음 갱신에서 한 번에 반영
+    const double Elapsed = Frame.Now - LastInterpolationTimes[AvatarIndex];
+    if (Elapsed < UpdateIntervals[AvatarIndex]) return;
+    LastInterpolationTimes[AvatarIndex] = Frame.Now;
+    const float DeltaTime = static_cast<float>(FMath::Min(Elapsed, static_cast<double>(MaxAvatarDeltaTime)));
+
+    if (Frame.bAdaptiveDelay && DeltaTime > 0.f)
+    {
+        SlewInterpolationDelay(AvatarIndex, DeltaTime);
+    }
+
+    const EAvatarOutput PrevMode = OutModes[AvatarIndex];
+    FVector Location;
+    FQuat Rotation;
+    const EAvatarOutput Mode = EvaluateAvatar(AvatarIndex, Frame, Location, Rotation);
+    OutModes[AvatarIndex] = Mode;
+    if (Mode == EAvatarOutput::None) return;
+    PendingPoses[AvatarIndex] = true;
+
+    FVector& Offset = BlendOffsets[AvatarIndex];
+    FQuat& RotationOffset = BlendRotations[AvatarIndex];
+
+    // 외삽하던 중 새 스냅샷이 도착하면 (또는 보간 구간으로 돌아오면) 지금 화면 위치와 새 위치의 차이를 오프셋으로 잡음
+    const bool bNewData = SeenSerials[AvatarIndex] != SnapshotSerials[AvatarIndex];
+    SeenSerials[AvatarIndex] = SnapshotSerials[AvatarIndex];
+    if (PrevMode == EAvatarOutput::Extrapolated && (bNewData || Mode != EAvatarOutput::Extrapolated))
+    {
+        const FVector Error = OutLocations[AvatarIndex] - Location;
+        if (Frame.ConvergenceTime > 0.f && Error.SizeSquared() < FMath::Square(MaxConvergenceDistance))
+        {
+            Offset = Error;
+            RotationOffset = OutRotations[AvatarIndex] * Rotation.Inverse();
+            RotationOffset.Normalize();
+        }
+        else
+        {
+            Offset = FVector::ZeroVector;
+            RotationOffset = FQuat::Identity;
+        }
+    }
+
+    // 오프셋은 지수적으로 감소 (프레임레이트와 무관하게 ConvergenceTime 마다 1/e)
+    const float Decay = Frame.ConvergenceTime > 0.f ? FMath::Exp(-DeltaTime / Frame.ConvergenceTime) : 0.f;
+    Offset *= Decay;
+    RotationOffset = FQuat::Slerp(FQuat::Identity, RotationOffset, Decay);
+
+    OutLocations[AvatarIndex] = Location + Offset;
+    OutRotations[AvatarIndex] = RotationOffset * Rotation;
+}
+
+void URemoteAvatarSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    const int32 Num = Actors.Num();
+    if (Num == 0) return;
+
+    FAvatarFrameParams Frame;
+    Frame.Now = FPknuClockSync::LocalNow();
+    Frame.bAdaptiveDelay = CVarPknuAvatarAdaptiveDelay.GetValueOnGameThread();
+    Frame.MaxExtrapolation = FMath::Max(CVarPknuAvatarMaxExtrapolation.GetValueOnGameThread(), 0.f);
+    Frame.ConvergenceTime = FMath::Max(CVarPknuAvatarConvergenceTime.GetValueOnGameThread(), 0.f);
+    Frame.GravityZ = GetWorld()->GetGravityZ();
+
+    // 0) 중요도 (주기적으로 게임 스레드에서)
+    if (Frame.Now >= NextSignificanceUpdateTime)
+    {
+        UpdateSignificance();
+        NextSignificanceUpdateTime = Frame.Now + SignificanceUpdateInterval;
+    }
+
+    // 1) 보간: 아바타끼리 공유하는 쓰기가 없으므로 그대로 나눠 실행 가능
+    const int32 ParallelThreshold = CVarPknuAvatarParallelThreshold.GetValueOnGameThread();
+    if (ParallelThreshold > 0 && Num >= ParallelThreshold)
+    {
+        ParallelFor(Num, [this, &Frame](int32 AvatarIndex) { InterpolateAvatar(AvatarIndex, Frame); });
+    }
+    else
+    {
+        for (int32 AvatarIndex = 0; AvatarIndex < Num; ++AvatarIndex)
+        {
+            InterpolateAvatar(AvatarIndex, Frame);
+        }
+    }
+
+    // 2) 액터 반영 (게임 스레드)
+    for (int32 AvatarIndex = 0; AvatarIndex < Num; ++AvatarIndex)
+    {
+        if (!PendingPoses[AvatarIndex]) continue;
+        PendingPoses[AvatarIndex] = false;
+
+        if (AMyRemoteCharacter* Actor = Actors[AvatarIndex].Get())
+        {
+            Actor->SetActorLocationAndRotation(OutLocations[AvatarIndex], OutRotations[AvatarIndex]);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TransformQuantization.h"
+#include "RemoteAvatarSubsystem.generated.h"
+
+class AMyRemoteCharacter;
+
+// 원격 캐릭터의 중요도 등급 (URemoteAvatarSubsystem 이 카메라 거리 / 화면 노출로 정함)
+enum class ERemoteAvatarSignificance : uint8
+{
+    High,   // 가까이 보임: 매 프레임 보간, 애니메이션 / 이름표 전체 속도
+    Medium, // 보이지만 멀거나 High 예산 초과: Pknu.Avatar.Significance.MediumInterval 주기
+    Low,    // 화면 밖이거나 아주 멂: Pknu.Avatar.Significance.LowInterval 주기, 이름표 숨김
+};
+
+/**
+ * 모든 원격 캐릭터의 스냅샷 버퍼와 보간을 한 곳에서 처리하는 월드 서브시스템.
+ *
+ * 아바타마다 액터 Tick 을 돌리는 대신, 스냅샷을 구조체 배열(SoA)로 모아 두고 프레임마다 한 번
+ * 전체를 훑어 보간한 뒤 결과만 액터에 반영한다. 아바타 수가 Pknu.Avatar.ParallelThreshold 이상이면
+ * 보간 단계는 ParallelFor 로 나눠 돌리고, 액터 갱신은 게임 스레드에서 한다.
+ *
+ * 아바타 인덱스는 조밀(dense)하게 유지된다. 제거 시 마지막 아바타를 빈자리로 옮기고 그 액터의 AvatarIndex 를 갱신한다.
+ * 스냅샷은 아바타마다 SnapshotCapacity 칸짜리 링 (Timestamp 오름차순, 가득 차면 가장 오래된 것부터 버림).
+ *
+ * 시간축은 FPknuClockSync::LocalNow. 스냅샷 Timestamp 는 송신 시각을 이 시계로 변환한 값이다
+ * (시계 동기화 전이거나 송신 시각이 없으면 도착 시각).
+ *
+ * 보간 지연은 아바타(= 원격 연결)마다 업데이트 도착 간격의 평균 / 편차로 정한다 (TCP RTO 추정과 같은 방식).
+ * 안정적인 연결은 최소 지연으로, 도착 간격이 들쭉날쭉한 연결은 다음 스냅샷이 올 때까지 버틸 만큼 지연을 늘린다.
+ * 송신 시각 기준 스냅샷은 전송 시간(도착 - 송신)만큼 과거이므로 그 평균도 지연에 더한다.
+ * 지연은 한 번에 바꾸지 않고 렌더 시간이 되감기지 않는 속도로 목표값에 따라간다.
+ *
+ * 두 스냅샷 사이는 위치를 3차 Hermite 곡선으로, 회전을 slerp 로 보간한다. 각 스냅샷의 속도(접선)는 앞뒤 스냅샷에서
+ * 구하고 (비균일 Catmull-Rom) 그 스냅샷의 speed 로 크기를 제한하므로, 송신 주기가 길어도 꺾이는 궤적이 되지 않는다.
+ *
+ * 패킷 손실 등으로 렌더 시간이 마지막 스냅샷을 넘어서면 마지막 두 스냅샷의 속도로 최대 Pknu.Avatar.MaxExtrapolation 초까지
+ * 외삽한다 (보낸 speed 로 크기를 제한, isFalling 이면 중력 적용). 새 스냅샷이 도착하면 외삽 위치와의 차이를
+ * Pknu.Avatar.ConvergenceTime 동안 줄여 나가므로 멈춤 / 순간이동 대신 부드럽게 수렴한다.
+ *
+ * 중요도: SignificanceUpdateInterval 마다 아바타를 카메라 거리와 최근 렌더 여부로 정렬해 등급을 매긴다.
+ * High 는 Pknu.Avatar.Significance.HighBudget 명까지만 허용하고, 등급에 따라 보간 주기와
+ * 액터의 애니메이션 / 이동 / 이름표 갱신 주기를 낮춘다 (AMyRemoteCharacter::SetSignificance).
+ */
+UCLASS()
+class PROJECT_PKNU_API URemoteAvatarSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // InitialDelay : 도착 간격 샘플이 모이기 전 (또는 Pknu.Avatar.AdaptiveDelay 0 일 때) 쓰는 보간 지연
+    int32 RegisterAvatar(AMyRemoteCharacter* Actor, float InitialDelay);
+    void UnregisterAvatar(int32 AvatarIndex);
+
+    void AddSnapshot(int32 AvatarIndex, const FVector& Location, const FQuat& Rotation, float Speed, bool bIsFalling, double Timestamp);
+
+    // 스냅샷 인코딩에 쓸 양자화 파라미터. 바뀌면 기존 스냅샷도 다시 인코딩함
+    void SetQuantizer(const FTransformQuantizer& InQuantizer);
+    const FTransformQuantizer& GetQuantizer() const { return Quantizer; }
+
+    // 송신 쪽 전송 주기 (UWebSocketManager::SendInterval). 도착 간격 샘플이 없을 때 정지 후 다시 움직이는 구간의 길이로 씀
+    void SetSenderInterval(float Seconds) { SenderInterval = FMath::Max(Seconds, 0.f); }
+
+    int32 NumAvatars() const { return Actors.Num(); }
+    ERemoteAvatarSignificance GetSignificance(int32 AvatarIndex) const { return Significances.IsValidIndex(AvatarIndex) ? Significances[AvatarIndex] : ERemoteAvatarSignificance::High; }
+    float GetInterpolationDelay(int32 AvatarIndex) const { return InterpolationDelays.IsValidIndex(AvatarIndex) ? InterpolationDelays[AvatarIndex] : 0.f; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    enum class EAvatarOutput : uint8
+    {
+        None,   // 이번 프레임은 위치를 바꾸지 않음
+        Pose,   // OutLocations / OutRotations 적용
+        Extrapolated, // Pose 와 같지만 마지막 스냅샷 이후를 추정한 값
+    };
+
+    // Tick 에서 한 번 읽어 모든 아바타에 넘기는 값 (CVar 는 게임 스레드에서만 읽음)
+    struct FAvatarFrameParams
+    {
+        double Now = 0.0;
+        bool bAdaptiveDelay = true;
+        float MaxExtrapolation = 0.f;
+        float ConvergenceTime = 0.f;
+        float GravityZ = 0.f;
+    };
+
+    // 링 안의 논리 인덱스(0 = 가장 오래된 스냅샷) -> 스냅샷 배열 인덱스
+    int32 SnapshotSlot(int32 AvatarIndex, int32 Index) const
+    {
+        return AvatarIndex * SnapshotCapacity + ((RingHeads[AvatarIndex] + Index) & SnapshotMask);
+    }
+
+    void InsertSnapshot(int32 AvatarIndex, double Timestamp, const FQuantizedTransform& Transform, float Speed);
+    void PopSnapshotsOlderThan(int32 AvatarIndex, double Time);
+    int32 FindLastSnapshotAtOrBefore(int32 AvatarIndex, double Time) const;
+    int32 FindInterpolationIndex(int32 AvatarIndex, double RenderTime);
+
+    // 도착 간격으로 평균 / 편차를, 도착 - 송신 시각으로 전송 시간을 갱신하고 목표 지연을 다시 계산
+    void UpdateJitterEstimate(int32 AvatarIndex, double ArrivalTime, double Timestamp);
+    // 현재 지연을 목표 지연 쪽으로 DeltaTime 만큼 이동
+    void SlewInterpolationDelay(int32 AvatarIndex, float DeltaTime);
+
+    // 카메라 기준으로 아바타를 정렬해 등급 / 보간 주기를 정하고, 바뀐 액터에만 알림 (게임 스레드)
+    void UpdateSignificance();
+
+    // 게임 스레드 밖에서도 호출됨 (자기 아바타의 커서 / 출력 / 수렴 오프셋만 기록)
+    // 등급의 보간 주기가 지나지 않았으면 아무것도 하지 않음
+    void InterpolateAvatar(int32 AvatarIndex, const FAvatarFrameParams& Frame);
+    // 수렴 오프셋을 적용하기 전의 위치 (None 이면 이번 프레임은 그대로 둠)
+    EAvatarOutput EvaluateAvatar(int32 AvatarIndex, const FAvatarFrameParams& Frame, FVector& OutLocation, FQuat& OutRotation);
+    // 논리 인덱스 Index 스냅샷에서의 속도 (앞뒤 스냅샷의 차분, 보고된 speed 로 크기 제한)
+    FVector SnapshotVelocity(int32 AvatarIndex, int32 Index) const;
+    // 마지막 스냅샷의 속도로 마지막 스냅샷에서 Ahead 초 뒤의 위치를 추정
+    FVector ExtrapolateLocation(int32 AvatarIndex, float Ahead, float GravityZ) const;
+
+    FTransformQuantizer Quantizer;
+    float SenderInterval = 0.f;
+    int32 SnapshotCapacity = 0;
+    int32 SnapshotMask = 0;
+
+    // 아바타별 (모두 같은 인덱스)
+    TArray<TWeakObjectPtr<AMyRemoteCharacter>> Actors;
+    TArray<float> InterpolationDelays;   // 현재 적용 중인 지연
+    TArray<float> TargetDelays;          // 지터 추정으로 정한 목표 지연
+    TArray<double> LastArrivalTimes;     // 마지막 업데이트 도착 시각 (0 = 아직 없음)
+    TArray<float> MeanArrivalIntervals;  // 도착 간격 평균 (0 = 샘플 없음)
+    TArray<float> ArrivalIntervalDeviations;
+    TArray<float> MeanTransitTimes;      // 도착 시각 - 스냅샷 Timestamp 평균 (도착 시각 기준이면 0)
+    TArray<int32> RingHeads;
+    TArray<int32> RingCounts;
+    TArray<int32> Cursors; // 지난 프레임의 보간 구간 시작 (논리 인덱스)
+    TArray<bool> LastFallingFlags;       // 가장 최근에 받은 isFalling
+    TArray<uint32> SnapshotSerials;      // 스냅샷이 추가될 때마다 증가
+    TArray<uint32> SeenSerials;          // 지난 프레임에 본 SnapshotSerials (외삽 중 새 데이터 도착 감지)
+    TArray<FVector> BlendOffsets;        // 실제 위치 + 오프셋 = 화면 위치. 프레임마다 0 으로 수렴
+    TArray<FQuat> BlendRotations;
+    TArray<ERemoteAvatarSignificance> Significances;
+    TArray<float> UpdateIntervals;       // 등급에 따른 보간 주기 (0 = 매 프레임)
+    TArray<double> LastInterpolationTimes;
+    TArray<bool> PendingPoses;           // 이번 프레임에 보간해서 액터에 반영할 위치가 있음
+    TArray<EAvatarOutput> OutModes;
+    TArray<FVector> OutLocations;
+    TArray<FQuat> OutRotations;
+
+    // UpdateSignificance 정렬용 (프레임마다 재사용)
+    double NextSignificanceUpdateTime = 0.0;
+    TArray<float> SignificanceScores;
+    TArray<int32> SignificanceOrder;
+
+    // 스냅샷 (아바타 x SnapshotCapacity)
+    TArray<double> SnapshotTimes;
+    TArray<FQuantizedTransform> SnapshotTransforms;
+    TArray<float> SnapshotSpeeds; // 송신자가 보고한 speed (cm/s)
+};
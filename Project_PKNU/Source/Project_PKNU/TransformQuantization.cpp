@@ -0,0 +1,118 @@
+#include "TransformQuantization.h"
+
+FTransformQuantizer::FTransformQuantizer(const FBox& InBounds, int32 InPositionBits, int32 InRotationBits)
+    : BoundsMin(InBounds.Min)
+    , BoundsMax(InBounds.Max)
+    , PositionBits(FMath::Clamp(InPositionBits, MinPositionBits, MaxPositionBits))
+    , RotationBits(FMath::Clamp(InRotationBits, MinRotationBits, MaxRotationBits))
+{
+}
+
+uint32 FTransformQuantizer::QuantizeAxis(double Value, double Min, double Max) const
+{
+    const double Range = Max - Min;
+    const uint32 MaxValue = (1u << PositionBits) - 1;
+    if (Range <= 0.0) return 0;
+
+    // 경계 밖의 값은 경계로 클램프
+    const double Alpha = FMath::Clamp((Value - Min) / Range, 0.0, 1.0);
+    return (uint32)FMath::RoundToInt64(Alpha * MaxValue);
+}
+
+double FTransformQuantizer::DequantizeAxis(uint32 Value, double Min, double Max) const
+{
+    const uint32 MaxValue = (1u << PositionBits) - 1;
+    return Min + (Max - Min) * ((double)Value / (double)MaxValue);
+}
+
+FQuantizedTransform FTransformQuantizer::Quantize(const FVector& Location, const FQuat& Rotation) const
+{
+    FQuantizedTransform Out;
+    Out.X = QuantizeAxis(Location.X, BoundsMin.X, BoundsMax.X);
+    Out.Y = QuantizeAxis(Location.Y, BoundsMin.Y, BoundsMax.Y);
+    Out.Z = QuantizeAxis(Location.Z, BoundsMin.Z, BoundsMax.Z);
+
+    // smallest-three: 절댓값이 가장 큰 성분은 생략하고 (부호를 양수로 맞춘 뒤) 나머지 셋만 저장
+    const FQuat Q = Rotation.GetNormalized();
+    const double Components[4] = { Q.X, Q.Y, Q.Z, Q.W };
+
+    uint32 Largest = 0;
+    for (uint32 i = 1; i < 4; ++i)
+    {
+        if (FMath::Abs(Components[i]) > FMath::Abs(Components[Largest]))
+        {
+            Largest = i;
+        }
+    }
+    const double Sign = Components[Largest] < 0.0 ? -1.0 : 1.0;
+
+    // 나머지 세 성분은 [-1/sqrt(2), 1/sqrt(2)] 범위
+    const double Limit = UE_INV_SQRT_2;
+    const uint32 MaxValue = (1u << RotationBits) - 1;
+
+    uint32 Packed = Largest;
+    int32 Shift = 2;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        if (i == Largest) continue;
+        const double Alpha = FMath::Clamp((Components[i] * Sign + Limit) / (2.0 * Limit), 0.0, 1.0);
+        Packed |= (uint32)FMath::RoundToInt64(Alpha * MaxValue) << Shift;
+        Shift += RotationBits;
+    }
+    Out.Rotation = Packed;
+
+    return Out;
+}
+
+FVector FTransformQuantizer::DequantizeLocation(const FQuantizedTransform& In) const
+{
+    return FVector(
+        DequantizeAxis(In.X, BoundsMin.X, BoundsMax.X),
+        DequantizeAxis(In.Y, BoundsMin.Y, BoundsMax.Y),
+        DequantizeAxis(In.Z, BoundsMin.Z, BoundsMax.Z));
+}
+
+FQuat FTransformQuantizer::DequantizeRotation(const FQuantizedTransform& In) const
+{
+    const double Limit = UE_INV_SQRT_2;
+    const uint32 Mask = (1u << RotationBits) - 1;
+    const uint32 Largest = In.Rotation & 3;
+
+    double Components[4] = { 0.0, 0.0, 0.0, 0.0 };
+    double SumSquares = 0.0;
+    int32 Shift = 2;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        if (i == Largest) continue;
+        const uint32 Value = (In.Rotation >> Shift) & Mask;
+        Components[i] = ((double)Value / (double)Mask) * (2.0 * Limit) - Limit;
+        SumSquares += Components[i] * Components[i];
+        Shift += RotationBits;
+    }
+    Components[Largest] = FMath::Sqrt(FMath::Max(0.0, 1.0 - SumSquares));
+
+    FQuat Out(Components[0], Components[1], Components[2], Components[3]);
+    Out.Normalize();
+    return Out;
+}
+
+void FTransformQuantizer::Pack(TArray<uint8>& Out, const FQuantizedTransform& In) const
+{
+    FQuantizedBitWriter Packer(Out);
+    Packer.Write(In.X, PositionBits);
+    Packer.Write(In.Y, PositionBits);
+    Packer.Write(In.Z, PositionBits);
+    Packer.Write(In.Rotation, 2 + 3 * RotationBits);
+    Packer.Flush();
+}
+
+bool FTransformQuantizer::Unpack(const uint8* Data, int32 Size, FQuantizedTransform& Out) const
+{
+    if (Size < GetPackedBytes()) return false;
+
+    FQuantizedBitReader Unpacker(Data, Size);
+    return Unpacker.Read(PositionBits, Out.X) &&
+        Unpacker.Read(PositionBits, Out.Y) &&
+        Unpacker.Read(PositionBits, Out.Z) &&
+        Unpacker.Read(2 + 3 * RotationBits, Out.Rotation);
+}
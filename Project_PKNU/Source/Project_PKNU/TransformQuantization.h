@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// LSB-first 비트 스트림 (server/protocol.js 의 BitWriter / BitReader 와 동일한 순서)
+struct FQuantizedBitWriter
+{
+    TArray<uint8>& Out;
+    uint64 Accumulator = 0;
+    int32 PendingBits = 0;
+
+    explicit FQuantizedBitWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+    void Write(uint32 Value, int32 NumBits)
+    {
+        Accumulator |= (uint64)(Value & (uint32)((1ull << NumBits) - 1)) << PendingBits;
+        PendingBits += NumBits;
+        while (PendingBits >= 8)
+        {
+            Out.Add((uint8)(Accumulator & 0xFF));
+            Accumulator >>= 8;
+            PendingBits -= 8;
+        }
+    }
+
+    // 남은 비트를 바이트 경계까지 패딩해서 기록
+    void Flush()
+    {
+        if (PendingBits > 0)
+        {
+            Out.Add((uint8)(Accumulator & 0xFF));
+            Accumulator = 0;
+            PendingBits = 0;
+        }
+    }
+};
+
+struct FQuantizedBitReader
+{
+    const uint8* Data;
+    int32 Size;
+    int32 ByteOffset = 0;
+    uint64 Accumulator = 0;
+    int32 AvailableBits = 0;
+
+    FQuantizedBitReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+    bool Read(int32 NumBits, uint32& OutValue)
+    {
+        while (AvailableBits < NumBits)
+        {
+            if (ByteOffset >= Size) return false;
+            Accumulator |= (uint64)Data[ByteOffset++] << AvailableBits;
+            AvailableBits += 8;
+        }
+        OutValue = (uint32)(Accumulator & ((1ull << NumBits) - 1));
+        Accumulator >>= NumBits;
+        AvailableBits -= NumBits;
+        return true;
+    }
+
+    // 지금까지 소비한 바이트 수 (마지막 바이트의 패딩 포함)
+    int32 GetBytesConsumed() const { return ByteOffset; }
+};
+
+// 양자화된 transform (위치 3축 고정소수점 + smallest-three 쿼터니언)
+struct FQuantizedTransform
+{
+    uint32 X = 0;
+    uint32 Y = 0;
+    uint32 Z = 0;
+    uint32 Rotation = 0; // [2bit: 생략된 성분 index][3 x RotationBits]
+
+    bool operator==(const FQuantizedTransform& Other) const
+    {
+        return X == Other.X && Y == Other.Y && Z == Other.Z && Rotation == Other.Rotation;
+    }
+    bool operator!=(const FQuantizedTransform& Other) const { return !(*this == Other); }
+};
+
+/**
+ * 레벨 경계(Bounds) 기준 위치 고정소수점 + smallest-three 회전 양자화.
+ * 와이어(바이너리 프레임)와 원격 캐릭터 스냅샷 버퍼가 같은 인코딩을 공유한다.
+ * 파라미터는 접속 시 서버와 합의하며 (hello / hello_ack), server/protocol.js 의 Quantizer 와 동일한 규칙을 따른다.
+ */
+struct PROJECT_PKNU_API FTransformQuantizer
+{
+    static constexpr int32 MinPositionBits = 8;
+    static constexpr int32 MaxPositionBits = 30;
+    static constexpr int32 MinRotationBits = 6;
+    static constexpr int32 MaxRotationBits = 10; // 2 + 3 * 10 = 32bit
+
+    FVector BoundsMin = FVector(-500000.0);
+    FVector BoundsMax = FVector(500000.0);
+    int32 PositionBits = 20;
+    int32 RotationBits = 10;
+
+    FTransformQuantizer() = default;
+    FTransformQuantizer(const FBox& InBounds, int32 InPositionBits, int32 InRotationBits);
+
+    FQuantizedTransform Quantize(const FVector& Location, const FQuat& Rotation) const;
+    FVector DequantizeLocation(const FQuantizedTransform& In) const;
+    FQuat DequantizeRotation(const FQuantizedTransform& In) const;
+
+    // 와이어에 기록되는 비트 수 / 바이트 수 (바이트 경계로 패딩)
+    int32 GetPackedBits() const { return 3 * PositionBits + 2 + 3 * RotationBits; }
+    int32 GetPackedBytes() const { return (GetPackedBits() + 7) / 8; }
+
+    // LSB-first 비트 패킹. Pack 은 Out 뒤에 GetPackedBytes() 만큼 추가한다
+    void Pack(TArray<uint8>& Out, const FQuantizedTransform& In) const;
+    bool Unpack(const uint8* Data, int32 Size, FQuantizedTransform& Out) const;
+
+    bool operator==(const FTransformQuantizer& Other) const
+    {
+        return BoundsMin == Other.BoundsMin && BoundsMax == Other.BoundsMax &&
+            PositionBits == Other.PositionBits && RotationBits == Other.RotationBits;
+    }
+    bool operator!=(const FTransformQuantizer& Other) const { return !(*this == Other); }
+
+private:
+    uint32 QuantizeAxis(double Value, double Min, double Max) const;
+    double DequantizeAxis(uint32 Value, double Min, double Max) const;
+};
@@ -1,15 +1,54 @@
 #include "WebSocketManager.h"
 #include "MyWebSocketCharacter.h"
 #include "MyRemoteCharacter.h"
+#include "RemoteAvatarSubsystem.h"
+#include "RemoteAvatarPool.h"
 #include "WebSocketsModule.h"
 #include "IWebSocket.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "Engine/World.h"
-#include "EngineUtils.h" // TActorIterator 사용
+#include "Components/PrimitiveComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "ChatWidget.h" // For handling chat UI
+#include "BinaryProtocol.h"
+#include "Engine/LevelBounds.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+    // Base 에서 Dt 초 동안 같은 속도 / 각속도(월드 축 deg/s)로 움직였을 때의 Transform
+    // 수신 쪽 목표 외삽과 송신 쪽 추측 항법이 같은 식을 써야 송신을 줄일 수 있음
+    FTransform ExtrapolateWorldObject(const FTransform& Base, const FVector& LinearVelocity, const FVector& AngularVelocity, double Dt)
+    {
+        FTransform Result = Base;
+        Result.SetLocation(Base.GetLocation() + LinearVelocity * Dt);
+
+        const double AngularSpeed = AngularVelocity.Size();
+        if (AngularSpeed > UE_KINDA_SMALL_NUMBER)
+        {
+            const FQuat Delta(AngularVelocity / AngularSpeed, FMath::DegreesToRadians(AngularSpeed * Dt));
+            Result.SetRotation((Delta * Base.GetRotation()).GetNormalized());
+        }
+        return Result;
+    }
+
+    // 물리 시뮬레이션 중이면 바디의 속도, 아니면 액터 속도 (각속도 없음)
+    void GetWorldObjectVelocity(AActor* Actor, FVector& OutLinearVelocity, FVector& OutAngularVelocity)
+    {
+        UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+        if (Primitive && Primitive->IsSimulatingPhysics())
+        {
+            OutLinearVelocity = Primitive->GetPhysicsLinearVelocity();
+            OutAngularVelocity = Primitive->GetPhysicsAngularVelocityInDegrees();
+            return;
+        }
+        OutLinearVelocity = Actor->GetVelocity();
+        OutAngularVelocity = FVector::ZeroVector;
+    }
+}
 
 UWebSocketManager::UWebSocketManager()
     : RemoteCharacterClass(nullptr)
@@ -18,7 +57,7 @@ UWebSocketManager::UWebSocketManager()
     , LastSentSpeed(0.0f)
     , bLastSentIsFalling(false)
     , bHasSentInitialTransform(false)
-    , SendInterval(0.1f) // 30ms 주기 (권장: 0.02 ~ 0.05)
+    , SendInterval(0.3f) // 받는 쪽이 Hermite 보간 + 외삽을 하므로 낮은 주기로도 충분
     , TimeSinceLastSend(0.0f)
 {
 }
@@ -28,6 +67,25 @@ void UWebSocketManager::Initialize(UClass* InRemoteCharacterClass, UWorld* InWor
     RemoteCharacterClass = InRemoteCharacterClass;
     World = InWorld;
     OwnerCharacter = nullptr;
+
+    // 원격 캐릭터는 풀에서 꺼내 쓰므로 접속 전에 미리 채워 둠
+    if (World)
+    {
+        WorldObjectIndex.Bind(World);
+
+        if (URemoteAvatarPool* Pool = World->GetSubsystem<URemoteAvatarPool>())
+        {
+            Pool->SetAvatarClass(RemoteCharacterClass);
+        }
+
+        // 레벨이 바뀌어 새 서브시스템이 생겼으면 지금까지 합의한 양자화 파라미터를 넘겨 둠 (이후 변경은 ApplyQuantizer)
+        if (URemoteAvatarSubsystem* Avatars = World->GetSubsystem<URemoteAvatarSubsystem>())
+        {
+            Avatars->SetQuantizer(Quantizer);
+            // 원격 플레이어도 같은 빌드의 같은 주기로 보냄
+            Avatars->SetSenderInterval(SendInterval);
+        }
+    }
 }
 
 void UWebSocketManager::Connect(const FString& InUsername)
@@ -43,6 +101,12 @@ void UWebSocketManager::Connect(const FString& InUsername)
     WebSocket->OnConnected().AddLambda([this]() {
         // UE_LOG(LogTemp, Warning, TEXT("WebSocket connected"));
 
+        // 바이너리 포맷 협상 요청. hello_ack 를 받기 전까지는 JSON 으로 전송
+        SendHello();
+
+        // 시계 동기화는 서버 단위 (첫 ping 은 다음 Tick 에서)
+        ClockSync.Reset();
+
         SendInitialWorldObjects();
 
         if (OwnerCharacter)
@@ -57,9 +121,17 @@ void UWebSocketManager::Connect(const FString& InUsername)
         OnWebSocketMessage(Msg);
         });
 
+    WebSocket->OnBinaryMessage().AddLambda([this](const void* Data, SIZE_T Size, bool bIsLastFragment) {
+        OnWebSocketBinaryMessage(Data, Size, bIsLastFragment);
+        });
+
     WebSocket->OnClosed().AddLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean) {
         UE_LOG(LogTemp, Warning, TEXT("WebSocket disconnected. Status Code: %d, Reason: %s, WasClean: %s"), StatusCode, *Reason, (bWasClean ? TEXT("true") : TEXT("false")));
         UnregisterPlayerCharacter(); // 로컬 플레이어 캐릭터 정리
+        bUseBinaryProtocol = false;
+        DeltaChannels.Reset();
+        Handles.ResetWireHandles(); // 서버 핸들은 세션 단위
+        ClockSync.Reset();
         });
 
     //WebSocket->OnError().AddLambda([this](const FString& Error) {
@@ -80,6 +152,11 @@ void UWebSocketManager::Close()
 void UWebSocketManager::RegisterPlayerCharacter(AMyWebSocketCharacter* InCharacter)
 {
     OwnerCharacter = InCharacter;
+    if (OwnerCharacter)
+    {
+        // 캐릭터가 민 월드 오브젝트를 알아야 다른 클라이언트가 소유한 오브젝트의 소유권을 요청할 수 있음
+        OwnerCharacter->OnActorHit.AddUniqueDynamic(this, &UWebSocketManager::OnOwnerCharacterHit);
+    }
     // The character is now registered only after the WebSocket connection is established.
     // See the OnConnected lambda in the Connect() function.
 }
@@ -94,44 +171,96 @@ void UWebSocketManager::UnregisterPlayerCharacter()
         UE_LOG(LogTemp, Warning, TEXT("Local player character unregistered due to WebSocket disconnection."));
     }
     MyPlayerId.Empty(); // 플레이어 ID 초기화
+    MyHandle = FPknuEntityHandle();
     bHasSentInitialTransform = false; // 초기 트랜스폼 전송 상태 초기화
 }
 
+void UWebSocketManager::SendHello()
+{
+    if (!WebSocket.IsValid() || !WebSocket->IsConnected()) return;
+
+    bUseBinaryProtocol = false;
+
+    // 양자화 기준: 현재 레벨 경계 + 여유 공간. 서버가 이미 다른 값을 쓰고 있으면 hello_ack 의 값을 따름
+    FBox LevelBounds(ForceInit);
+    if (World && World->PersistentLevel)
+    {
+        LevelBounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+    }
+    if (LevelBounds.IsValid)
+    {
+        ApplyQuantizer(FTransformQuantizer(LevelBounds.ExpandBy(QuantizationBoundsPadding), PositionQuantizationBits, RotationQuantizationBits));
+    }
+    else
+    {
+        FTransformQuantizer Defaults;
+        ApplyQuantizer(FTransformQuantizer(FBox(Defaults.BoundsMin, Defaults.BoundsMax), PositionQuantizationBits, RotationQuantizationBits));
+    }
+
+    TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("type"), TEXT("hello"));
+    Root->SetNumberField(TEXT("binary"), FPknuBinaryProtocol::Version);
+    // 초기 상태를 압축 청크(StateChunk)로 받을 수 있음
+    Root->SetBoolField(TEXT("stateChunks"), true);
+
+    TSharedPtr<FJsonObject> QuantObj = MakeShared<FJsonObject>();
+    TArray<TSharedPtr<FJsonValue>> MinArr = { MakeShared<FJsonValueNumber>(Quantizer.BoundsMin.X), MakeShared<FJsonValueNumber>(Quantizer.BoundsMin.Y), MakeShared<FJsonValueNumber>(Quantizer.BoundsMin.Z) };
+    TArray<TSharedPtr<FJsonValue>> MaxArr = { MakeShared<FJsonValueNumber>(Quantizer.BoundsMax.X), MakeShared<FJsonValueNumber>(Quantizer.BoundsMax.Y), MakeShared<FJsonValueNumber>(Quantizer.BoundsMax.Z) };
+    QuantObj->SetArrayField(TEXT("min"), MinArr);
+    QuantObj->SetArrayField(TEXT("max"), MaxArr);
+    QuantObj->SetNumberField(TEXT("positionBits"), Quantizer.PositionBits);
+    QuantObj->SetNumberField(TEXT("rotationBits"), Quantizer.RotationBits);
+    Root->SetObjectField(TEXT("quant"), QuantObj);
+
+    FString OutString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutString);
+    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+    WebSocket->Send(OutString);
+}
+
+void UWebSocketManager::ApplyQuantizer(const FTransformQuantizer& InQuantizer)
+{
+    // 원격 캐릭터 스냅샷도 같은 파라미터로 (이미 쌓인 스냅샷은 서브시스템이 다시 인코딩)
+    if (URemoteAvatarSubsystem* Avatars = World ? World->GetSubsystem<URemoteAvatarSubsystem>() : nullptr)
+    {
+        Avatars->SetQuantizer(InQuantizer);
+    }
+
+    Quantizer = InQuantizer;
+}
+
 void UWebSocketManager::SendRegisterCharacter()
 {
     if (!OwnerCharacter) return;
 
     // 서버가 ID를 할당하므로 클라이언트는 ID를 생성하지 않음
     // MyPlayerId는 서버로부터 'id' 메시지를 수신했을 때 설정됨
-    TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-    Root->SetStringField(TEXT("type"), TEXT("register_character"));
-    Root->SetStringField(TEXT("playerID"), MyPlayerId); // MyPlayerId는 아직 비어있음
-
-    TSharedPtr<FJsonObject> MetaObject = MakeShared<FJsonObject>();
-    MetaObject->SetStringField(TEXT("playerName"), MyPlayerName);
-    Root->SetObjectField(TEXT("meta"), MetaObject);
-
     FVector Loc = OwnerCharacter->GetActorLocation();
     FRotator Rot = OwnerCharacter->GetActorRotation();
 
-    TSharedPtr<FJsonObject> Pos = MakeShared<FJsonObject>();
-    Pos->SetNumberField(TEXT("x"), Loc.X);
-    Pos->SetNumberField(TEXT("y"), Loc.Y);
-    Pos->SetNumberField(TEXT("z"), Loc.Z);
+    JsonWriter.BeginObject();
+    JsonWriter.WriteString(TEXT("type"), TEXT("register_character"));
+    JsonWriter.WriteString(TEXT("playerID"), MyPlayerId); // MyPlayerId는 아직 비어있음
 
-    TSharedPtr<FJsonObject> RotObj = MakeShared<FJsonObject>();
-    RotObj->SetNumberField(TEXT("pitch"), Rot.Pitch);
-    RotObj->SetNumberField(TEXT("yaw"), Rot.Yaw);
-    RotObj->SetNumberField(TEXT("roll"), Rot.Roll);
+    JsonWriter.BeginObject(TEXT("meta"));
+    JsonWriter.WriteString(TEXT("playerName"), MyPlayerName);
+    JsonWriter.EndObject();
 
-    Root->SetObjectField(TEXT("position"), Pos);
-    Root->SetObjectField(TEXT("rotation"), RotObj);
+    JsonWriter.BeginObject(TEXT("position"));
+    JsonWriter.WriteNumber(TEXT("x"), Loc.X);
+    JsonWriter.WriteNumber(TEXT("y"), Loc.Y);
+    JsonWriter.WriteNumber(TEXT("z"), Loc.Z);
+    JsonWriter.EndObject();
 
-    FString OutString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutString);
-    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+    JsonWriter.BeginObject(TEXT("rotation"));
+    JsonWriter.WriteNumber(TEXT("pitch"), Rot.Pitch);
+    JsonWriter.WriteNumber(TEXT("yaw"), Rot.Yaw);
+    JsonWriter.WriteNumber(TEXT("roll"), Rot.Roll);
+    JsonWriter.EndObject();
+    JsonWriter.EndObject();
 
-    WebSocket->Send(OutString);
+    WebSocket->Send(JsonWriter.GetOutput());
 }
 
 void UWebSocketManager::SendTransformData()
@@ -142,41 +271,63 @@ void UWebSocketManager::SendTransformData()
     float Speed = OwnerCharacter->GetVelocity().Size();
     bool bIsFalling = OwnerCharacter->GetCharacterMovement()->IsFalling();
 
-    SendUpdate(TEXT("player"), MyPlayerId, CurrentTransform, Speed, bIsFalling);
+    SendUpdate(TEXT("player"), MyHandle, CurrentTransform, Speed, bIsFalling);
 }
 
 // SendUpdate: 기존 JSON에 타임스탬프(ts, ms)를 추가
-void UWebSocketManager::SendUpdate(const FString& EntityType, const FString& ID, const FTransform& Transform, float Speed, bool bIsFalling)
+void UWebSocketManager::SendUpdate(const FString& EntityType, FPknuEntityHandle Handle, const FTransform& Transform, float Speed, bool bIsFalling)
 {
     if (!WebSocket.IsValid() || !WebSocket->IsConnected()) return;
 
-    TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-    Root->SetStringField(TEXT("type"), TEXT("transform"));
-    Root->SetStringField(TEXT("id"), ID);
+    // 서버 시계 기준 송신 시각 (ms). 서버가 update_batch 로 그대로 전달하고 받는 쪽이 자기 시계로 변환
+    // 동기화 전에는 UTC 로 대신함 (서버 시계도 UTC 이므로 두 컴퓨터의 시계 오차만큼만 틀림)
+    double Millis = 0.0;
+    if (ClockSync.IsSynchronized())
+    {
+        Millis = ClockSync.LocalToServerMs(FPknuClockSync::LocalNow());
+    }
+    else
+    {
+        const FDateTime UtcNow = FDateTime::UtcNow();
+        Millis = static_cast<double>((UtcNow.ToUnixTimestamp() * 1000LL) + UtcNow.GetMillisecond());
+    }
+
+    // 바이너리 프레임은 서버 핸들로 식별하므로 handle_map 을 받기 전까지는 JSON 으로 보냄
+    const uint32 WireHandle = Handles.GetWireHandle(Handle);
+    if (bUseBinaryProtocol && WireHandle != 0)
+    {
+        // ack 된 baseline 대비 달라진 필드만 전송
+        FPknuDeltaFrame Frame;
+        Frame.WireHandle = WireHandle;
+        Frame.State.Transform = Quantizer.Quantize(Transform.GetLocation(), Transform.GetRotation());
+        Frame.State.Speed = (uint16)FMath::Clamp(FMath::RoundToInt32(Speed), 0, (int32)MAX_uint16);
+        Frame.State.bIsFalling = bIsFalling;
+        Frame.Timestamp = Millis;
+        DeltaChannels.FindOrAdd(Handle).Prepare(Frame.State, DeltaKeyframeInterval, Frame.Seq, Frame.Baseline, Frame.FieldMask);
+
+        FPknuBinaryProtocol::EncodeDelta(BinarySendBuffer, EPknuBinaryMessage::Transform, Frame, Quantizer);
+        SendBinaryFrame(BinarySendBuffer);
+        return;
+    }
 
     FVector Loc = Transform.GetLocation();
     FRotator Rot = Transform.GetRotation().Rotator();
 
-    Root->SetNumberField(TEXT("x"), Loc.X);
-    Root->SetNumberField(TEXT("y"), Loc.Y);
-    Root->SetNumberField(TEXT("z"), Loc.Z);
-    Root->SetNumberField(TEXT("pitch"), Rot.Pitch);
-    Root->SetNumberField(TEXT("yaw"), Rot.Yaw);
-    Root->SetNumberField(TEXT("roll"), Rot.Roll);
-    Root->SetNumberField(TEXT("speed"), Speed);
-    Root->SetBoolField(TEXT("isFalling"), bIsFalling);
-
-    // --- 추가: 밀리초 단위 타임스탬프 (UTC) ---
-    FDateTime UtcNow = FDateTime::UtcNow();
-    int64 Millis = (UtcNow.ToUnixTimestamp() * 1000LL) + (UtcNow.GetMillisecond());
-    Root->SetNumberField(TEXT("ts"), static_cast<double>(Millis));
-    // --------------------------------------------
-
-    FString OutString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutString);
-    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
-
-    WebSocket->Send(OutString);
+    JsonWriter.BeginObject();
+    JsonWriter.WriteString(TEXT("type"), TEXT("transform"));
+    JsonWriter.WriteString(TEXT("id"), Handles.GetName(Handle));
+    JsonWriter.WriteNumber(TEXT("x"), Loc.X);
+    JsonWriter.WriteNumber(TEXT("y"), Loc.Y);
+    JsonWriter.WriteNumber(TEXT("z"), Loc.Z);
+    JsonWriter.WriteNumber(TEXT("pitch"), Rot.Pitch);
+    JsonWriter.WriteNumber(TEXT("yaw"), Rot.Yaw);
+    JsonWriter.WriteNumber(TEXT("roll"), Rot.Roll);
+    JsonWriter.WriteNumber(TEXT("speed"), Speed);
+    JsonWriter.WriteBool(TEXT("isFalling"), bIsFalling);
+    JsonWriter.WriteNumber(TEXT("ts"), Millis);
+    JsonWriter.EndObject();
+
+    SendJsonFrame(JsonWriter.GetOutput());
 }
 
 
@@ -184,319 +335,473 @@ void UWebSocketManager::SendChatMessage(const FString& Message)
 {
     if (!OwnerCharacter || !WebSocket.IsValid() || !WebSocket->IsConnected()) return;
 
-    TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-    Root->SetStringField(TEXT("type"), TEXT("chat"));
-    Root->SetStringField(TEXT("playerID"), MyPlayerId);
-    Root->SetStringField(TEXT("message"), Message);
+    JsonWriter.BeginObject();
+    JsonWriter.WriteString(TEXT("type"), TEXT("chat"));
+    JsonWriter.WriteString(TEXT("playerID"), MyPlayerId);
+    JsonWriter.WriteString(TEXT("message"), Message);
+    JsonWriter.EndObject();
 
-    FString OutString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutString);
-    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+    UE_LOG(LogTemp, Warning, TEXT("Sending chat message: PlayerID=%s, Message=%s, JSON=%s"), *MyPlayerId, *Message, *JsonWriter.GetOutput());
 
-    UE_LOG(LogTemp, Warning, TEXT("Sending chat message: PlayerID=%s, Message=%s, JSON=%s"), *MyPlayerId, *Message, *OutString);
-
-    WebSocket->Send(OutString);
+    WebSocket->Send(JsonWriter.GetOutput());
 }
 
 void UWebSocketManager::OnWebSocketMessage(const FString& Message)
 {
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject)) return;
+    // DOM 을 만들지 않고 한 번에 타입 구조체로 읽음 (Inbound 는 메시지마다 재사용)
+    if (!FPknuInboundDecoder::Decode(Message, Inbound)) return;
 
-    FString Type = JsonObject->GetStringField(TEXT("type"));
+    if (InboundRoutes.Num() == 0)
+    {
+        RegisterInboundRoutes();
+    }
 
-    if (Type == TEXT("id"))
+    // (type, action) 해시 한 번으로 핸들러 선택. action 이 없는 메시지는 (type, "") 로 등록됨
+    FPknuInboundRoute* Route = FindInboundRoute(Inbound.Type, Inbound.Action);
+    if (!Route && !Inbound.Action.IsEmpty())
     {
-                  MyPlayerId = JsonObject->GetStringField(TEXT("id"));        if (OwnerCharacter)
-            OwnerCharacter->SetName(MyPlayerName); // Use the chosen player name
+        Route = FindInboundRoute(Inbound.Type, FStringView());
     }
-    else if (Type == TEXT("state_sync"))
+    if (!Route) return;
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    (this->*Route->Handler)(Inbound);
+    Route->Cycles += FPlatformTime::Cycles64() - StartCycles;
+    ++Route->CallCount;
+}
+
+uint32 UWebSocketManager::MakeInboundRouteKey(FStringView Type, FStringView Action)
+{
+    return HashCombineFast(
+        FCrc::MemCrc32(Type.GetData(), Type.Len() * sizeof(TCHAR)),
+        FCrc::MemCrc32(Action.GetData(), Action.Len() * sizeof(TCHAR)));
+}
+
+void UWebSocketManager::RegisterInboundRoute(const TCHAR* Type, const TCHAR* Action, FPknuInboundHandler Handler)
+{
+    const uint32 Key = MakeInboundRouteKey(Type, Action);
+    checkf(!InboundRouteIndex.Contains(Key), TEXT("Inbound route hash collision: %s/%s"), Type, Action);
+
+    FPknuInboundRoute& Route = InboundRoutes.AddDefaulted_GetRef();
+    Route.Type = Type;
+    Route.Action = Action;
+    Route.Handler = Handler;
+    InboundRouteIndex.Add(Key, InboundRoutes.Num() - 1);
+}
+
+void UWebSocketManager::RegisterInboundRoutes()
+{
+    InboundRoutes.Reset();
+    InboundRouteIndex.Reset();
+
+    RegisterInboundRoute(TEXT("hello_ack"), TEXT(""), &UWebSocketManager::HandleHelloAck);
+    RegisterInboundRoute(TEXT("pong"), TEXT(""), &UWebSocketManager::HandlePong);
+    RegisterInboundRoute(TEXT("handle_map"), TEXT(""), &UWebSocketManager::HandleHandleMap);
+    RegisterInboundRoute(TEXT("id"), TEXT(""), &UWebSocketManager::HandleId);
+    RegisterInboundRoute(TEXT("state_sync"), TEXT(""), &UWebSocketManager::HandleStateSync);
+    RegisterInboundRoute(TEXT("transform"), TEXT(""), &UWebSocketManager::HandlePlayerTransform);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("add_object"), &UWebSocketManager::HandleWorldObjectUpdate);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("update"), &UWebSocketManager::HandleWorldObjectUpdate);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("add_character"), &UWebSocketManager::HandleCharacterState);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("transform"), &UWebSocketManager::HandleCharacterState);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("remove_character"), &UWebSocketManager::HandleRemoveCharacter);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("new_chat"), &UWebSocketManager::HandleNewChat);
+    RegisterInboundRoute(TEXT("render_update"), TEXT("update_batch"), &UWebSocketManager::HandleUpdateBatch);
+}
+
+FPknuInboundRoute* UWebSocketManager::FindInboundRoute(FStringView Type, FStringView Action)
+{
+    const int32* Index = InboundRouteIndex.Find(MakeInboundRouteKey(Type, Action));
+    if (!Index) return nullptr;
+
+    // 해시가 우연히 같은 다른 문자열 방지
+    FPknuInboundRoute& Route = InboundRoutes[*Index];
+    const bool bMatches = FStringView(Route.Type).Equals(Type, ESearchCase::CaseSensitive) && FStringView(Route.Action).Equals(Action, ESearchCase::CaseSensitive);
+    return bMatches ? &Route : nullptr;
+}
+
+void UWebSocketManager::DumpInboundStats(bool bReset)
+{
+    UE_LOG(LogTemp, Log, TEXT("%-32s %10s %12s %10s"), TEXT("Handler (type/action)"), TEXT("Calls"), TEXT("Total ms"), TEXT("Avg us"));
+    for (FPknuInboundRoute& Route : InboundRoutes)
     {
-        OnInitialStateSynced.Broadcast();
+        const double TotalMs = FPlatformTime::ToMilliseconds64(Route.Cycles);
+        const double AvgUs = Route.CallCount > 0 ? TotalMs * 1000.0 / Route.CallCount : 0.0;
+        UE_LOG(LogTemp, Log, TEXT("%-32s %10llu %12.3f %10.2f"),
+            *FString::Printf(TEXT("%s/%s"), *Route.Type, *Route.Action), Route.CallCount, TotalMs, AvgUs);
 
-        // Handle initial player characters
-        const TArray<TSharedPtr<FJsonValue>>* PlayerArr;
-        if (JsonObject->TryGetArrayField(TEXT("playerCharacters"), PlayerArr))
+        if (bReset)
         {
-            for (const auto& Val : *PlayerArr)
-            {
-                const TSharedPtr<FJsonObject>* PlayerObject;
-                if (Val->TryGetObject(PlayerObject))
-                {
-                    FString PlayerID = (*PlayerObject)->GetStringField(TEXT("playerID"));
-                    const TSharedPtr<FJsonObject>* StateObject;
-                    if ((*PlayerObject)->TryGetObjectField(TEXT("state"), StateObject))
-                    {
-                        const TSharedPtr<FJsonObject>* PosObject = nullptr;
-                        const TSharedPtr<FJsonObject>* RotObject = nullptr;
-                        if ((*StateObject)->TryGetObjectField(TEXT("position"), PosObject) && (*StateObject)->TryGetObjectField(TEXT("rotation"), RotObject))
-                        {
-                            FVector Location((*PosObject)->GetNumberField(TEXT("x")), (*PosObject)->GetNumberField(TEXT("y")), (*PosObject)->GetNumberField(TEXT("z")));
-                            FRotator Rotation((*RotObject)->GetNumberField(TEXT("pitch")), (*RotObject)->GetNumberField(TEXT("yaw")), (*RotObject)->GetNumberField(TEXT("roll")));
-
-                            float Speed = (*StateObject)->GetNumberField(TEXT("speed"));
-                            bool bIsFalling = (*StateObject)->GetBoolField(TEXT("isFalling"));
-
-                            FString PlayerName = PlayerID; // Default to PlayerID
-                            const TSharedPtr<FJsonObject>* MetaObject;
-                            if ((*StateObject)->TryGetObjectField(TEXT("meta"), MetaObject))
-                            {
-                                if ((*MetaObject)->HasField(TEXT("playerName")))
-                                {
-                                    PlayerName = (*MetaObject)->GetStringField(TEXT("playerName"));
-                                }
-                            }
-                            
-                            // 도착 시간을 기준으로 타임스탬프 생성
-                            const double Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
-                            SpawnOrUpdateRemoteCharacter(PlayerID, FTransform(Rotation, Location), Speed, bIsFalling, PlayerName, Timestamp);
-                        }
-                    }
-                }
-            }
+            Route.CallCount = 0;
+            Route.Cycles = 0;
         }
     }
-    else if (Type == TEXT("render_update"))
-    {
-        FString Action = JsonObject->GetStringField(TEXT("action"));
+}
 
-        // ✅ ✅ [월드 오브젝트 업데이트]
-        if (Action == TEXT("add_object") || (Action == TEXT("update") && JsonObject->GetBoolField(TEXT("isObject"))))
+static FAutoConsoleCommand GPknuDumpHandlerStatsCommand(
+    TEXT("Pknu.Net.DumpHandlerStats"),
+    TEXT("Logs call count and time per inbound message handler. Usage: Pknu.Net.DumpHandlerStats [reset]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const bool bReset = Args.Num() > 0 && Args[0] == TEXT("reset");
+        for (TObjectIterator<UWebSocketManager> It; It; ++It)
         {
-            UE_LOG(LogTemp, Warning, TEXT("서버로부터 수신"));
-            FString ObjectID = JsonObject->GetStringField(TEXT("id"));
-            const TSharedPtr<FJsonObject>* StateObject;
+            It->DumpInboundStats(bReset);
+        }
+    }));
 
-            if (JsonObject->TryGetObjectField(TEXT("state"), StateObject))
-            {
-                const TSharedPtr<FJsonObject>* PosObject = nullptr;
-                const TSharedPtr<FJsonObject>* RotObject = nullptr;
+void UWebSocketManager::HandleHelloAck(const FPknuInboundMessage& Msg)
+{
+    // 서버가 같은 버전을 지원할 때만 바이너리로 전환 (구버전 서버는 hello 자체를 무시함)
+    bUseBinaryProtocol = (Msg.BinaryVersion == FPknuBinaryProtocol::Version);
+    DeltaChannels.Reset(); // 새 세션은 키프레임부터 시작
 
-                if ((*StateObject)->TryGetObjectField(TEXT("position"), PosObject) &&
-                    (*StateObject)->TryGetObjectField(TEXT("rotation"), RotObject))
-                {
-                    FVector Location((*PosObject)->GetNumberField(TEXT("x")),
-                        (*PosObject)->GetNumberField(TEXT("y")),
-                        (*PosObject)->GetNumberField(TEXT("z")));
-                    FRotator Rotation((*RotObject)->GetNumberField(TEXT("pitch")),
-                        (*RotObject)->GetNumberField(TEXT("yaw")),
-                        (*RotObject)->GetNumberField(TEXT("roll")));
-
-                    // 서버에서 받은 transform → 절대 재전송 금지
-                    SpawnOrUpdateWorldObject(ObjectID, FTransform(Rotation, Location), false);
-                }
-            }
-        }
-        else if (Action == TEXT("add_character")) // Handle new character addition
-        {
-            FString PlayerID = JsonObject->GetStringField(TEXT("playerID"));
-            const TSharedPtr<FJsonObject>* StateObject;
-            if (JsonObject->TryGetObjectField(TEXT("state"), StateObject))
-            {
-                const TSharedPtr<FJsonObject>* PosObject = nullptr;
-                const TSharedPtr<FJsonObject>* RotObject = nullptr;
-                if ((*StateObject)->TryGetObjectField(TEXT("position"), PosObject) && (*StateObject)->TryGetObjectField(TEXT("rotation"), RotObject))
-                {
-                    FVector Location((*PosObject)->GetNumberField(TEXT("x")), (*PosObject)->GetNumberField(TEXT("y")), (*PosObject)->GetNumberField(TEXT("z")));
-                    FRotator Rotation((*RotObject)->GetNumberField(TEXT("pitch")), (*RotObject)->GetNumberField(TEXT("yaw")), (*RotObject)->GetNumberField(TEXT("roll")));
-
-                    float Speed = (*StateObject)->GetNumberField(TEXT("speed"));
-                    bool bIsFalling = (*StateObject)->GetBoolField(TEXT("isFalling"));
-
-                    FString PlayerName = PlayerID; // Default to PlayerID
-                    const TSharedPtr<FJsonObject>* MetaObject;
-                    if ((*StateObject)->TryGetObjectField(TEXT("meta"), MetaObject))
-                    {
-                        if ((*MetaObject)->HasField(TEXT("playerName")))
-                        {
-                            PlayerName = (*MetaObject)->GetStringField(TEXT("playerName"));
-                        }
-                    }
-
-                    // 도착 시간을 기준으로 타임스탬프 생성
-                    const double Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
-                    SpawnOrUpdateRemoteCharacter(PlayerID, FTransform(Rotation, Location), Speed, bIsFalling, PlayerName, Timestamp);
-                }
-            }
-        }
+    // 서버가 확정한 양자화 파라미터 (모든 바이너리 클라이언트가 동일한 값을 사용해야 함)
+    if (Msg.bHasQuant)
+    {
+        ApplyQuantizer(FTransformQuantizer(Msg.QuantBounds, Msg.PositionBits, Msg.RotationBits));
+    }
+    UE_LOG(LogTemp, Log, TEXT("Wire format negotiated: %s"), bUseBinaryProtocol ? TEXT("binary") : TEXT("json"));
+}
 
+void UWebSocketManager::SendPing()
+{
+    // 송신 배칭을 거치지 않고 바로 보냄 (배칭 대기 시간이 왕복의 한쪽에만 더해지면 offset 이 치우침)
+    const double Now = FPknuClockSync::LocalNow();
+    JsonWriter.BeginObject();
+    JsonWriter.WriteString(TEXT("type"), TEXT("ping"));
+    JsonWriter.WriteNumber(TEXT("t0"), Now);
+    JsonWriter.EndObject();
+    WebSocket->Send(JsonWriter.GetOutput());
+
+    ClockSync.OnPingSent(Now);
+}
 
-        else if (Action == TEXT("transform")) // 서버에서 보내는 transform 처리
-        {
-            const TSharedPtr<FJsonObject>* StateObject;
-            if (JsonObject->TryGetObjectField(TEXT("state"), StateObject))
-            {
-                const TSharedPtr<FJsonObject>* PosObject = nullptr;
-                const TSharedPtr<FJsonObject>* RotObject = nullptr; // 반드시 nullptr로 초기화
+void UWebSocketManager::HandlePong(const FPknuInboundMessage& Msg)
+{
+    // t0 : 이 ping 을 보낸 로컬 시각, ts : 서버가 pong 을 만든 시각 (서버 시계 ms)
+    if (Msg.PingSentTime <= 0.0 || Msg.Timestamp <= 0.0) return;
 
-                if ((*StateObject)->TryGetObjectField(TEXT("position"), PosObject) &&
-                    (*StateObject)->TryGetObjectField(TEXT("rotation"), RotObject))
-                {
-                    FVector Location(
-                        (*PosObject)->GetNumberField(TEXT("x")),
-                        (*PosObject)->GetNumberField(TEXT("y")),
-                        (*PosObject)->GetNumberField(TEXT("z"))
-                    );
-                    FRotator Rotation(
-                        (*RotObject)->GetNumberField(TEXT("pitch")),
-                        (*RotObject)->GetNumberField(TEXT("yaw")),
-                        (*RotObject)->GetNumberField(TEXT("roll"))
-                    );
-
-                    float Speed = (*StateObject)->GetNumberField(TEXT("speed"));
-                    bool bIsFalling = (*StateObject)->GetBoolField(TEXT("isFalling"));
-                    FString PlayerID = JsonObject->GetStringField(TEXT("playerID"));
-
-                    FString PlayerName = PlayerID; // Default to PlayerID
-                    const TSharedPtr<FJsonObject>* MetaObject;
-                    if ((*StateObject)->TryGetObjectField(TEXT("meta"), MetaObject))
-                    {
-                        if ((*MetaObject)->HasField(TEXT("playerName")))
-                        {
-                            PlayerName = (*MetaObject)->GetStringField(TEXT("playerName"));
-                        }
-                    }
-
-                    // 도착 시간을 기준으로 타임스탬프 생성
-                    const double Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
-                    SpawnOrUpdateRemoteCharacter(PlayerID, FTransform(Rotation, Location), Speed, bIsFalling, PlayerName, Timestamp);
-                }
-            }
-        }
-        else if (Action == TEXT("remove_character"))
+    const bool bWasSynchronized = ClockSync.IsSynchronized();
+    ClockSync.AddSample(Msg.PingSentTime, Msg.Timestamp, FPknuClockSync::LocalNow());
+    if (!bWasSynchronized && ClockSync.IsSynchronized())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Clock synchronized with server: rtt=%.1fms"), ClockSync.GetRoundTripTime() * 1000.0);
+    }
+}
+
+double UWebSocketManager::ToSnapshotTime(double SenderTimestampMs) const
+{
+    const double Now = FPknuClockSync::LocalNow();
+    if (!ClockSync.IsSynchronized() || SenderTimestampMs <= 0.0) return Now;
+
+    // 아직 오지 않은 시각은 송신자 쪽 시계 추정 오차이므로 도착 시각으로 제한
+    return FMath::Min(ClockSync.ServerMsToLocal(SenderTimestampMs), Now);
+}
+
+void UWebSocketManager::HandleHandleMap(const FPknuInboundMessage& Msg)
+{
+    // 서버가 할당한 엔티티 핸들. 이후 메시지/바이너리 프레임은 이 핸들로 엔티티를 가리킴
+    for (const FPknuNetEntityState& Entry : Msg.GetEntities())
+    {
+        Handles.BindWire(Entry.WireHandle, Entry.ID);
+    }
+    for (uint32 Released : Msg.ReleasedHandles)
+    {
+        Handles.UnbindWire(Released);
+    }
+}
+
+void UWebSocketManager::HandleId(const FPknuInboundMessage& Msg)
+{
+    MyPlayerId = Msg.ID;
+    MyHandle = ResolveHandle(Msg.WireHandle, MyPlayerId);
+    if (OwnerCharacter)
+        OwnerCharacter->SetName(MyPlayerName); // Use the chosen player name
+}
+
+void UWebSocketManager::HandleStateSync(const FPknuInboundMessage& Msg)
+{
+    OnInitialStateSynced.Broadcast();
+    ApplyStateSyncEntities(Msg);
+}
+
+void UWebSocketManager::HandleStateChunk(const uint8* Data, int32 Size)
+{
+    FPknuStateChunkHeader Header;
+    if (!FPknuBinaryProtocol::DecodeStateChunk(Data, Size, Header, StateChunkUtf8))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Invalid state chunk (%d bytes)"), Size);
+        return;
+    }
+
+    // 청크 하나는 state_sync 와 같은 형태이므로 텍스트 메시지와 같은 디코더 사용
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(StateChunkUtf8.GetData()), StateChunkUtf8.Num());
+    StateChunkText.Reset(Converted.Length());
+    StateChunkText.AppendChars(Converted.Get(), Converted.Length());
+    if (FPknuInboundDecoder::Decode(StateChunkText, Inbound))
+    {
+        ApplyStateSyncEntities(Inbound);
+    }
+
+    // 적용을 알려야 서버가 다음 청크를 보냄 (디코딩에 실패한 청크도 건너뛰고 진행)
+    JsonWriter.BeginObject();
+    JsonWriter.WriteString(TEXT("type"), TEXT("state_chunk_ack"));
+    JsonWriter.WriteNumber(TEXT("syncId"), Header.SyncId);
+    JsonWriter.WriteNumber(TEXT("chunk"), Header.Chunk);
+    JsonWriter.EndObject();
+    SendJsonFrame(JsonWriter.GetOutput());
+
+    if (Header.Chunk + 1 == Header.ChunkCount)
+    {
+        OnInitialStateSynced.Broadcast();
+    }
+}
+
+void UWebSocketManager::ApplyStateSyncEntities(const FPknuInboundMessage& Msg)
+{
+    // Handle initial player characters
+    // 도착 시간을 기준으로 타임스탬프 생성
+    const double Timestamp = FPknuClockSync::LocalNow();
+    for (const FPknuNetEntityState& Player : Msg.GetEntities())
+    {
+        if (!Player.HasTransform()) continue;
+
+        const FPknuEntityHandle Handle = ResolveHandle(Player.WireHandle, Player.ID);
+        if (Handle == MyHandle) continue;
+
+        const FString& PlayerName = Player.PlayerName.IsEmpty() ? Player.ID : Player.PlayerName; // Default to PlayerID
+        SpawnOrUpdateRemoteCharacter(Handle, FTransform(Player.Rotation, Player.Location), Player.Speed, Player.bIsFalling, PlayerName, Timestamp);
+    }
+
+    // 월드 오브젝트 (청크 항목마다 h 가 있으므로 handle_map 없이도 핸들이 연결됨)
+    for (const FPknuNetEntityState& Object : Msg.GetObjects())
+    {
+        if (!Object.HasTransform()) continue;
+
+        // 서버에서 받은 transform → 절대 재전송 금지
+        SpawnOrUpdateWorldObject(ResolveHandle(Object.WireHandle, Object.ID), FTransform(Object.Rotation, Object.Location), false);
+    }
+}
+
+void UWebSocketManager::HandleWorldObjectUpdate(const FPknuInboundMessage& Msg)
+{
+    // ✅ ✅ [월드 오브젝트 업데이트] add_object, 또는 isObject 가 붙은 update 만 처리
+    if (Msg.Action == TEXT("update") && !Msg.bIsObject) return;
+
+    UE_LOG(LogTemp, Warning, TEXT("서버로부터 수신"));
+    const FPknuNetEntityState& State = Msg.State;
+    if (State.HasTransform())
+    {
+        // 서버에서 받은 transform → 절대 재전송 금지
+        SpawnOrUpdateWorldObject(ResolveHandle(Msg.WireHandle, Msg.ID), FTransform(State.Rotation, State.Location), false);
+    }
+}
+
+void UWebSocketManager::HandleCharacterState(const FPknuInboundMessage& Msg)
+{
+    // 새 캐릭터(add_character) / 서버에서 보내는 transform 처리
+    const FPknuNetEntityState& State = Msg.State;
+    if (!State.HasTransform()) return;
+
+    const FString& PlayerName = State.PlayerName.IsEmpty() ? Msg.PlayerID : State.PlayerName; // Default to PlayerID
+
+    // 도착 시간을 기준으로 타임스탬프 생성
+    const double Timestamp = FPknuClockSync::LocalNow();
+    SpawnOrUpdateRemoteCharacter(ResolveHandle(Msg.WireHandle, Msg.PlayerID), FTransform(State.Rotation, State.Location), State.Speed, State.bIsFalling, PlayerName, Timestamp);
+}
+
+void UWebSocketManager::HandleRemoveCharacter(const FPknuInboundMessage& Msg)
+{
+    const FPknuEntityHandle Handle = ResolveHandle(Msg.WireHandle, Msg.PlayerID);
+    AMyRemoteCharacter* CharToRemove = nullptr;
+    if (OtherPlayersMap.RemoveAndCopyValue(Handle, CharToRemove))
+    {
+        if (CharToRemove)
         {
-            FString PlayerID = JsonObject->GetStringField(TEXT("playerID"));
-            if (OtherPlayersMap.Contains(PlayerID))
+            // 파괴하지 않고 풀에 반납 (스폰 / GC 비용 없이 다음 add_character 에 재사용)
+            if (URemoteAvatarPool* Pool = World ? World->GetSubsystem<URemoteAvatarPool>() : nullptr)
             {
-                AMyRemoteCharacter* CharToRemove = OtherPlayersMap[PlayerID];
-                if (CharToRemove)
-                {
-                    CharToRemove->Destroy();
-                }
-                OtherPlayersMap.Remove(PlayerID);
+                Pool->Release(CharToRemove);
             }
-        }
-        else if (Action == TEXT("new_chat")) // Handle incoming chat messages from server
-        {
-            FString SenderName = JsonObject->GetStringField(TEXT("playerID")); // Server now sends playerName in playerID field
-            FString MessageText = JsonObject->GetStringField(TEXT("message"));
-            // No need to check if SenderId == MyPlayerId here, as the server should handle not sending back to sender,
-            // or the ChatWidgetInstance can handle it if needed.
-            // For now, just add the message.
-            if (OwnerCharacter && OwnerCharacter->ChatWidgetInstance)
+            else
             {
-                OwnerCharacter->ChatWidgetInstance->AddChatMessage(SenderName, MessageText);
+                CharToRemove->Destroy();
             }
         }
-        else if (Action == TEXT("update_batch")) // New block for update_batch
-        {
-            const TArray<TSharedPtr<FJsonValue>>* PlayersArray;
-            if (JsonObject->TryGetArrayField(TEXT("players"), PlayersArray))
-            {
-                // 도착 시간을 기준으로 타임스탬프 생성 (배치 내 모든 플레이어에게 동일하게 적용)
-                const double Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+    }
+    Handles.Release(Handle);
+}
 
-                for (const auto& PlayerValue : *PlayersArray)
-                {
-                    const TSharedPtr<FJsonObject>* PlayerObject;
-                    if (PlayerValue->TryGetObject(PlayerObject))
-                    {
-                        FString PlayerID = (*PlayerObject)->GetStringField(TEXT("playerID"));
-                        const TSharedPtr<FJsonObject>* StateObject;
-                        if ((*PlayerObject)->TryGetObjectField(TEXT("state"), StateObject))
-                        {
-                            const TSharedPtr<FJsonObject>* PosObject = nullptr;
-                            const TSharedPtr<FJsonObject>* RotObject = nullptr;
-                            if ((*StateObject)->TryGetObjectField(TEXT("position"), PosObject) && (*StateObject)->TryGetObjectField(TEXT("rotation"), RotObject))
-                            {
-                                FVector Location((*PosObject)->GetNumberField(TEXT("x")), (*PosObject)->GetNumberField(TEXT("y")), (*PosObject)->GetNumberField(TEXT("z")));
-                                FRotator Rotation((*RotObject)->GetNumberField(TEXT("pitch")), (*RotObject)->GetNumberField(TEXT("yaw")), (*RotObject)->GetNumberField(TEXT("roll")));
-
-                                float Speed = (*StateObject)->GetNumberField(TEXT("speed"));
-                                bool bIsFalling = (*StateObject)->GetBoolField(TEXT("isFalling"));
-
-                                FString PlayerName = PlayerID; // Default to PlayerID
-                                const TSharedPtr<FJsonObject>* MetaObject;
-                                if ((*StateObject)->TryGetObjectField(TEXT("meta"), MetaObject))
-                                {
-                                    if ((*MetaObject)->HasField(TEXT("playerName")))
-                                    {
-                                        PlayerName = (*MetaObject)->GetStringField(TEXT("playerName"));
-                                    }
-                                }
-                                
-                                SpawnOrUpdateRemoteCharacter(PlayerID, FTransform(Rotation, Location), Speed, bIsFalling, PlayerName, Timestamp);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+void UWebSocketManager::HandleNewChat(const FPknuInboundMessage& Msg)
+{
+    // Server now sends playerName in playerID field
+    if (OwnerCharacter && OwnerCharacter->ChatWidgetInstance)
+    {
+        OwnerCharacter->ChatWidgetInstance->AddChatMessage(Msg.PlayerID, Msg.Message);
+    }
+}
+
+void UWebSocketManager::HandleUpdateBatch(const FPknuInboundMessage& Msg)
+{
+    // 서버 틱 하나의 스냅샷. 플레이어마다 송신 시각(ts)을 로컬 시계로 변환해 스냅샷 시각으로 사용
+    for (const FPknuNetEntityState& Player : Msg.GetEntities())
+    {
+        if (!Player.HasTransform()) continue;
+
+        // 서버는 모든 클라이언트에 같은 배치를 보내므로 내 캐릭터는 건너뜀
+        const FPknuEntityHandle Handle = ResolveHandle(Player.WireHandle, Player.ID);
+        if (Handle == MyHandle) continue;
+
+        const FString& PlayerName = Player.PlayerName.IsEmpty() ? Player.ID : Player.PlayerName; // Default to PlayerID
+        SpawnOrUpdateRemoteCharacter(Handle, FTransform(Player.Rotation, Player.Location), Player.Speed, Player.bIsFalling, PlayerName, ToSnapshotTime(Player.Timestamp));
     }
-    else if (Type == TEXT("transform"))
+
+    // 내가 옮긴 오브젝트(src == 내 핸들)는 이미 로컬에 반영되어 있음
+    const uint32 MyWireHandle = Handles.GetWireHandle(MyHandle);
+    for (const FPknuNetEntityState& Object : Msg.GetObjects())
     {
-        FString SenderId = JsonObject->GetStringField(TEXT("id"));
-        // UE_LOG(LogTemp, Warning, TEXT("[CLIENT RECEIVED TRANSFORM] SenderId=%s, MyPlayerId=%s"), *SenderId, *MyPlayerId);
+        if (!Object.HasTransform()) continue;
 
-        if (!MyPlayerId.IsEmpty() && SenderId == MyPlayerId)
+        const FPknuEntityHandle Handle = ResolveHandle(Object.WireHandle, Object.ID);
+        if (MyWireHandle != 0 && Object.SourceHandle == MyWireHandle)
         {
-            // UE_LOG(LogTemp, Warning, TEXT("Ignoring own transform message."));
-            return;
+            // 서버가 내 transform 을 받아들였음 → 소유권만 확인 (위치는 이미 로컬에 반영되어 있음)
+            const int32 Row = WorldObjects.Find(Handle);
+            if (Row != INDEX_NONE) SetWorldObjectOwner(Row, MyWireHandle);
+            continue;
         }
 
-        FVector NewLoc(JsonObject->GetNumberField(TEXT("x")),
-            JsonObject->GetNumberField(TEXT("y")),
-            JsonObject->GetNumberField(TEXT("z")));
-        FRotator NewRot(JsonObject->GetNumberField(TEXT("pitch")),
-            JsonObject->GetNumberField(TEXT("yaw")),
-            JsonObject->GetNumberField(TEXT("roll")));
+        // 서버에서 받은 transform → 절대 재전송 금지. src 는 이 오브젝트의 시뮬레이션 소유자
+        SpawnOrUpdateWorldObject(Handle, FTransform(Object.Rotation, Object.Location), false,
+            Object.LinearVelocity, Object.AngularVelocity, Object.SourceHandle);
+    }
+}
+
+void UWebSocketManager::HandlePlayerTransform(const FPknuInboundMessage& Msg)
+{
+    const FString& SenderId = Msg.ID;
+    const FPknuEntityHandle SenderHandle = ResolveHandle(Msg.WireHandle, SenderId);
+    // UE_LOG(LogTemp, Warning, TEXT("[CLIENT RECEIVED TRANSFORM] SenderId=%s, MyPlayerId=%s"), *SenderId, *MyPlayerId);
+
+    if (MyHandle.IsValid() && SenderHandle == MyHandle)
+    {
+        // UE_LOG(LogTemp, Warning, TEXT("Ignoring own transform message."));
+        return;
+    }
 
-        float Speed = JsonObject->GetNumberField(TEXT("speed"));
-        bool bIsFalling = JsonObject->GetBoolField(TEXT("isFalling"));
+    // transform 메시지는 위치/회전이 루트에 있고, 이름만 state.meta 에 있음
+    const FPknuNetEntityState& State = Msg.State;
+    const FString& PlayerName = State.PlayerName.IsEmpty() ? SenderId : State.PlayerName; // Default to SenderId
 
-        FString PlayerName = SenderId; // Default to SenderId
-        const TSharedPtr<FJsonObject>* StateObject;
-        if (JsonObject->TryGetObjectField(TEXT("state"), StateObject))
+    // 송신 시각(ts)이 있으면 그 시각, 없으면 도착 시간을 기준으로 타임스탬프 생성
+    SpawnOrUpdateRemoteCharacter(SenderHandle, FTransform(State.Rotation, State.Location), State.Speed, State.bIsFalling, PlayerName, ToSnapshotTime(Msg.Timestamp));
+}
+
+void UWebSocketManager::OnWebSocketBinaryMessage(const void* Data, SIZE_T Size, bool bIsLastFragment)
+{
+    // 프레임이 여러 조각으로 나뉘어 올 수 있으므로 마지막 조각까지 모은 뒤 디코딩
+    const uint8* Bytes = static_cast<const uint8*>(Data);
+    if (!bIsLastFragment || BinaryReceiveBuffer.Num() > 0)
+    {
+        BinaryReceiveBuffer.Append(Bytes, Size);
+        if (!bIsLastFragment) return;
+        Bytes = BinaryReceiveBuffer.GetData();
+        Size = BinaryReceiveBuffer.Num();
+    }
+
+    EPknuBinaryMessage Kind = EPknuBinaryMessage::Transform; // 클라이언트 -> 서버 전용 종류 (아래 분기에 걸리지 않음)
+    FPknuBinaryProtocol::PeekKind(Bytes, static_cast<int32>(Size), Kind);
+    if (Kind == EPknuBinaryMessage::Ack)
+    {
+        // 서버가 받은 seq → 다음 델타의 baseline 으로 사용
+        if (FPknuBinaryProtocol::DecodeAck(Bytes, static_cast<int32>(Size), AckScratch))
         {
-            const TSharedPtr<FJsonObject>* MetaObject;
-            if ((*StateObject)->TryGetObjectField(TEXT("meta"), MetaObject))
+            for (const FPknuAckEntry& Entry : AckScratch)
             {
-                if ((*MetaObject)->HasField(TEXT("playerName")))
+                if (FDeltaSendChannel* Channel = DeltaChannels.Find(Handles.FindByWire(Entry.WireHandle)))
                 {
-                    PlayerName = (*MetaObject)->GetStringField(TEXT("playerName"));
+                    Channel->Acknowledge(Entry.Seq);
                 }
             }
         }
+        BinaryReceiveBuffer.Reset();
+        return;
+    }
 
-        // 도착 시간을 기준으로 타임스탬프 생성
-        const double Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
-        SpawnOrUpdateRemoteCharacter(SenderId, FTransform(NewRot, NewLoc), Speed, bIsFalling, PlayerName, Timestamp);
+    if (Kind == EPknuBinaryMessage::StateChunk)
+    {
+        HandleStateChunk(Bytes, static_cast<int32>(Size));
+        BinaryReceiveBuffer.Reset();
+        return;
     }
+
+    if (Kind == EPknuBinaryMessage::UpdateBatch)
+    {
+        const bool bBatchDecoded = FPknuBinaryProtocol::DecodeUpdateBatch(Bytes, static_cast<int32>(Size), Quantizer, UpdateBatchPlayers, UpdateBatchObjects);
+        BinaryReceiveBuffer.Reset();
+        if (bBatchDecoded)
+        {
+            ApplyBinaryUpdateBatch();
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Invalid update batch frame (%d bytes)"), static_cast<int32>(Size));
+        }
+        return;
+    }
+
+    // 서버가 보내는 바이너리 프레임은 위의 세 종류뿐
+    BinaryReceiveBuffer.Reset();
+    UE_LOG(LogTemp, Warning, TEXT("Unexpected binary frame (kind %d, %d bytes)"), static_cast<int32>(Kind), static_cast<int32>(Size));
 }
 
-void UWebSocketManager::SpawnOrUpdateWorldObject(const FString& ObjectID, const FTransform& TargetTransform, bool bIsLocalUpdate /*= false*/)
+void UWebSocketManager::ApplyBinaryUpdateBatch()
 {
-    if (!World) return;
+    // HandleUpdateBatch 와 같은 규칙. handle_map 보다 먼저 도착한 항목은 버림
+    for (const FPknuBinaryTransform& Player : UpdateBatchPlayers)
+    {
+        const FPknuEntityHandle Handle = Handles.FindByWire(Player.WireHandle);
+        if (!Handle.IsValid() || Handle == MyHandle) continue;
 
-    AActor* Actor = nullptr;
+        SpawnOrUpdateRemoteCharacter(Handle, FTransform(Player.Rotation, Player.Location), Player.Speed, Player.bIsFalling, Handles.GetName(Handle), ToSnapshotTime(Player.Timestamp));
+    }
 
-    // 1) 기존 Actor 가져오기
-    if (RemoteWorldObjectsMap.Contains(ObjectID))
+    const uint32 MyWireHandle = Handles.GetWireHandle(MyHandle);
+    for (const FPknuBinaryTransform& Object : UpdateBatchObjects)
     {
-        Actor = RemoteWorldObjectsMap[ObjectID];
+        const FPknuEntityHandle Handle = Handles.FindByWire(Object.WireHandle);
+        if (!Handle.IsValid()) continue;
+
+        if (MyWireHandle != 0 && Object.SourceHandle == MyWireHandle)
+        {
+            const int32 Row = WorldObjects.Find(Handle);
+            if (Row != INDEX_NONE) SetWorldObjectOwner(Row, MyWireHandle);
+            continue;
+        }
+
+        SpawnOrUpdateWorldObject(Handle, FTransform(Object.Rotation, Object.Location), false,
+            Object.LinearVelocity, Object.AngularVelocity, Object.SourceHandle);
     }
-    else
+}
+
+void UWebSocketManager::SpawnOrUpdateWorldObject(FPknuEntityHandle Handle, const FTransform& TargetTransform, bool bIsLocalUpdate,
+    const FVector& LinearVelocity, const FVector& AngularVelocity, uint32 OwnerWireHandle)
+{
+    if (!World || !Handle.IsValid()) return;
+
+    // 1) 기존 Actor 가져오기
+    int32 Row = WorldObjects.Find(Handle);
+    AActor* Actor = Row != INDEX_NONE ? WorldObjects.Actors[Row].Get() : nullptr;
+    if (!Actor)
     {
-        for (TActorIterator<AActor> It(World); It; ++It)
+        // 처음 보는 오브젝트만 이름 색인에서 검색
+        WorldObjectIndex.Bind(World);
+        Actor = WorldObjectIndex.Find(Handles.GetName(Handle));
+        if (Actor)
         {
-            AActor* ExistingActor = *It;
-            if (ExistingActor && ExistingActor->GetName() == ObjectID)
-            {
-                Actor = ExistingActor;
-                RemoteWorldObjectsMap.Add(ObjectID, Actor);
-                break;
-            }
+            Row = WorldObjects.FindOrAdd(Handle);
+            WorldObjects.Actors[Row] = Actor;
         }
     }
 
@@ -505,20 +810,35 @@ void UWebSocketManager::SpawnOrUpdateWorldObject(const FString& ObjectID, const
     {
         if (!bIsLocalUpdate) // 서버에서 받은 Transform
         {
-            // 목표 Transform 저장
-            WorldObjectTargetTransforms.Add(ObjectID, TargetTransform);
-            WorldObjectLastReceiveTime.Add(ObjectID, FDateTime::UtcNow().ToUnixTimestamp() + FDateTime::UtcNow().GetMillisecond() / 1000.0);
-            // 기본 보간 속도 설정 (필요시 조절)
-            if (!WorldObjectInterpSpeeds.Contains(ObjectID))
+            // 목표 Transform 과 속도 저장 (보간 속도는 행의 기본값) 후 보간 대상으로 깨움
+            const double Now = FPknuClockSync::LocalNow();
+            WorldObjects.TargetTransforms[Row] = TargetTransform;
+            WorldObjects.LinearVelocities[Row] = LinearVelocity;
+            WorldObjects.AngularVelocities[Row] = AngularVelocity;
+            WorldObjects.ReceiveTimes[Row] = Now;
+            WorldObjects.Flags[Row] |= EPknuWorldObjectFlags::HasTarget;
+            if (OwnerWireHandle != 0)
             {
-                WorldObjectInterpSpeeds.Add(ObjectID, 1.f); // 기본 보간 속도
+                SetWorldObjectOwner(Row, OwnerWireHandle);
             }
+
+            // 로컬 물리도 소유자의 속도로 움직여 다음 목표까지 같은 궤적을 예측
+            UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+            if (Primitive && Primitive->IsSimulatingPhysics())
+            {
+                Primitive->SetPhysicsLinearVelocity(LinearVelocity);
+                Primitive->SetPhysicsAngularVelocityInDegrees(AngularVelocity);
+            }
+            WorldObjects.Wake(Row);
         }
         else // 로컬에서 직접 이동
         {
+            // 로컬 이동이 이전에 받은 목표보다 우선 (남은 보간이 되돌리지 않도록 목표도 갱신)
+            WorldObjects.TargetTransforms[Row] = TargetTransform;
             Actor->SetActorLocationAndRotation(TargetTransform.GetLocation(), TargetTransform.GetRotation());
-            SendWorldObjectTransform(ObjectID, TargetTransform);
-            LastSentTransforms.Add(ObjectID, TargetTransform);
+            // 게임 코드가 직접 옮긴 위치이므로 소유권을 요청
+            SendWorldObjectTransformByHandle(Handle, TargetTransform, FVector::ZeroVector, FVector::ZeroVector, true);
+            RecordWorldObjectSend(Row, TargetTransform, FVector::ZeroVector, FVector::ZeroVector);
         }
         return;
     }
@@ -526,22 +846,26 @@ void UWebSocketManager::SpawnOrUpdateWorldObject(const FString& ObjectID, const
     // 3) Actor가 없으면 새로 스폰
     FActorSpawnParameters Params;
     Actor = World->SpawnActor<AActor>(AActor::StaticClass(), TargetTransform, Params);
-    if (Actor)
+    if (!Actor)
     {
-        RemoteWorldObjectsMap.Add(ObjectID, Actor);
-        // 스폰된 액터의 초기 Transform을 목표로 설정
-        WorldObjectTargetTransforms.Add(ObjectID, TargetTransform);
-        WorldObjectLastReceiveTime.Add(ObjectID, FDateTime::UtcNow().ToUnixTimestamp() + FDateTime::UtcNow().GetMillisecond() / 1000.0);
-        if (!WorldObjectInterpSpeeds.Contains(ObjectID))
+        if (bIsLocalUpdate)
         {
-            WorldObjectInterpSpeeds.Add(ObjectID, 1.f); // 기본 보간 속도
+            SendWorldObjectTransformByHandle(Handle, TargetTransform, FVector::ZeroVector, FVector::ZeroVector, true);
         }
+        return;
     }
 
+    Row = WorldObjects.FindOrAdd(Handle);
+    WorldObjects.Actors[Row] = Actor;
+    // 스폰된 액터의 초기 Transform을 목표로 설정 (이미 목표 위치이므로 깨우지 않음)
+    WorldObjects.TargetTransforms[Row] = TargetTransform;
+    WorldObjects.ReceiveTimes[Row] = FPknuClockSync::LocalNow();
+    WorldObjects.Flags[Row] |= EPknuWorldObjectFlags::HasTarget;
+
     if (bIsLocalUpdate)
     {
-        SendWorldObjectTransform(ObjectID, TargetTransform);
-        LastSentTransforms.Add(ObjectID, TargetTransform);
+        SendWorldObjectTransformByHandle(Handle, TargetTransform, FVector::ZeroVector, FVector::ZeroVector, true);
+        RecordWorldObjectSend(Row, TargetTransform, FVector::ZeroVector, FVector::ZeroVector);
     }
 }
 
@@ -550,7 +874,7 @@ void UWebSocketManager::SpawnOrUpdateWorldObject(const FString& ObjectID, const
 
 
 
-void UWebSocketManager::SpawnOrUpdateRemoteCharacter(const FString& PlayerID, const FTransform& Transform, float Speed, bool bIsFalling, const FString& InPlayerName, double Timestamp)
+void UWebSocketManager::SpawnOrUpdateRemoteCharacter(FPknuEntityHandle Handle, const FTransform& Transform, float Speed, bool bIsFalling, const FString& InPlayerName, double Timestamp)
 
 
 
@@ -571,7 +895,7 @@ void UWebSocketManager::SpawnOrUpdateRemoteCharacter(const FString& PlayerID, co
 
 
 
-    if (!MyPlayerId.IsEmpty() && PlayerID == MyPlayerId)
+    if (!Handle.IsValid() || (MyHandle.IsValid() && Handle == MyHandle))
 
 
 
@@ -620,7 +944,7 @@ void UWebSocketManager::SpawnOrUpdateRemoteCharacter(const FString& PlayerID, co
 
 
 
-    AMyRemoteCharacter* ExistingChar = OtherPlayersMap.FindRef(PlayerID);
+    AMyRemoteCharacter* ExistingChar = OtherPlayersMap.FindRef(Handle);
 
 
 
@@ -690,28 +1014,16 @@ void UWebSocketManager::SpawnOrUpdateRemoteCharacter(const FString& PlayerID, co
 
 
 
-    FActorSpawnParameters Params;
-
-
-
-
-
-
-    // It is better to let the engine handle the name to avoid conflicts, we track by PlayerID in our map.
-
-
-
-
-
+    // 풀에서 숨겨 둔 캐릭터를 꺼내 씀 (비어 있으면 풀이 스폰)
+    URemoteAvatarPool* Pool = World->GetSubsystem<URemoteAvatarPool>();
+    if (!Pool) return;
 
-    // Params.Name = FName(*PlayerID);
 
 
 
 
 
-
-    AMyRemoteCharacter* NewChar = World->SpawnActor<AMyRemoteCharacter>(RemoteCharacterClass, Transform, Params); // Initial spawn transform
+    AMyRemoteCharacter* NewChar = Pool->Acquire(Transform); // Initial spawn transform
 
 
 
@@ -753,7 +1065,7 @@ void UWebSocketManager::SpawnOrUpdateRemoteCharacter(const FString& PlayerID, co
 
 
 
-        OtherPlayersMap.Add(PlayerID, NewChar);
+        OtherPlayersMap.Add(Handle, NewChar);
 
 
 
@@ -787,8 +1099,19 @@ void UWebSocketManager::Tick(float DeltaTime)
     TimeSinceLastSend += DeltaTime;
     TimeSinceLastWorldSend += DeltaTime;
 
+    // 시계 동기화는 캐릭터 등록과 관계없이 접속 직후부터
+    if (WebSocket.IsValid() && WebSocket->IsConnected() && ClockSync.ShouldSendPing(FPknuClockSync::LocalNow()))
+    {
+        SendPing();
+    }
+
     if (!OwnerCharacter || MyPlayerId.IsEmpty() || !WebSocket.IsValid() || !WebSocket->IsConnected()) return;
 
+    const double Now = FPknuClockSync::LocalNow();
+
+    // 1), 2) 에서 나가는 메시지는 모아서 한 프레임으로 전송
+    BeginOutboundBatch();
+
     // 1) 플레이어 위치 전송
     if (TimeSinceLastSend >= SendInterval)
     {
@@ -805,7 +1128,7 @@ void UWebSocketManager::Tick(float DeltaTime)
 
         if (bPlayerChanged)
         {
-            SendUpdate(TEXT("player"), MyPlayerId, CurrentTransform, Speed, bIsFalling);
+            SendUpdate(TEXT("player"), MyHandle, CurrentTransform, Speed, bIsFalling);
 
             LastSentLocation = CurrentTransform.GetLocation();
             LastSentRotation = CurrentTransform.GetRotation().Rotator();
@@ -817,69 +1140,165 @@ void UWebSocketManager::Tick(float DeltaTime)
         TimeSinceLastSend = 0.f;
     }
 
-    // 2) 로컬에서 움직인 월드 오브젝트만 전송
-    const float WorldSendInterval = SendInterval+0.2f;
+    // 2) 로컬에서 움직인 월드 오브젝트 중 이 클라이언트가 시뮬레이션하는 것만 전송
     if (TimeSinceLastWorldSend >= WorldSendInterval)
     {
-        for (auto& Elem : TrackedWorldObjects)
+        const uint32 MyWireHandle = Handles.GetWireHandle(MyHandle);
+
+        // 마지막 확인 이후 루트 컴포넌트가 움직인 오브젝트만 (WatchTrackedWorldObject)
+        // 보냈거나 보낼 필요가 없는 행은 목록에서 빠지고 마지막 항목이 이 자리로 오므로 DirtyIndex 유지
+        for (int32 DirtyIndex = 0; DirtyIndex < WorldObjects.DirtyHandles.Num();)
         {
-            const FString& ObjectID = Elem.Key;
-            TWeakObjectPtr<AActor> ActorPtr = Elem.Value;
-            if (!ActorPtr.IsValid()) continue; // 유효성 검사
+            const FPknuEntityHandle Handle = WorldObjects.DirtyHandles[DirtyIndex];
+            const int32 Row = WorldObjects.Find(Handle);
+            AActor* Actor = Row != INDEX_NONE ? WorldObjects.Actors[Row].Get() : nullptr;
+            if (!Actor)
+            {
+                WorldObjects.ClearDirty(DirtyIndex);
+                continue;
+            }
 
-            AActor* Actor = ActorPtr.Get(); // 실제 포인터 가져오기
-            if (!Actor) continue;
+            // 다른 클라이언트가 소유한 오브젝트는 로컬 물리 결과를 보내지 않음 (직접 밀었을 때만 소유권 요청)
+            const uint32 Owner = WorldObjects.OwnerHandles[Row];
+            const bool bOwnedByOther = Owner != 0 && Owner != MyWireHandle && Now < WorldObjects.OwnerExpireTimes[Row];
+            const bool bPushed = Now - WorldObjects.LastPushTimes[Row] <= WorldPushClaimWindow;
+            if (bOwnedByOther && !bPushed)
+            {
+                WorldObjects.ClearDirty(DirtyIndex);
+                continue;
+            }
 
             FTransform CurrentTransform = Actor->GetActorTransform();
+            FVector LinearVelocity, AngularVelocity;
+            GetWorldObjectVelocity(Actor, LinearVelocity, AngularVelocity);
+            if (LinearVelocity.SizeSquared() < FMath::Square(WorldRestSpeed)) LinearVelocity = FVector::ZeroVector;
+            if (AngularVelocity.SizeSquared() < FMath::Square(WorldRestSpeed)) AngularVelocity = FVector::ZeroVector;
+
             bool bSignificantChange = true;
+            bool bStillMoving = false;
 
-            if (LastSentTransforms.Contains(ObjectID))
+            if (WorldObjects.HasFlags(Row, EPknuWorldObjectFlags::HasLastSent))
             {
-                const FTransform& LastTransform = LastSentTransforms[ObjectID];
-                FVector DeltaLoc = CurrentTransform.GetLocation() - LastTransform.GetLocation();
-                float AngleDeg = FMath::RadiansToDegrees(CurrentTransform.GetRotation().AngularDistance(LastTransform.GetRotation()));
-                bSignificantChange = (DeltaLoc.Size() > WorldPosThreshold) || (AngleDeg > WorldRotThreshold);
+                // 받는 쪽이 마지막 전송 상태에서 외삽했을 위치와 비교 (예측대로 움직이는 동안에는 보내지 않음)
+                const double Elapsed = Now - WorldObjects.LastSentTimes[Row];
+                const FVector& LastLinearVelocity = WorldObjects.LastSentLinearVelocities[Row];
+                const FVector& LastAngularVelocity = WorldObjects.LastSentAngularVelocities[Row];
+                const FTransform Predicted = ExtrapolateWorldObject(WorldObjects.LastSentTransforms[Row], LastLinearVelocity, LastAngularVelocity,
+                    FMath::Min(Elapsed, (double)WorldMaxExtrapolationTime));
+
+                FVector DeltaLoc = CurrentTransform.GetLocation() - Predicted.GetLocation();
+                float AngleDeg = FMath::RadiansToDegrees(CurrentTransform.GetRotation().AngularDistance(Predicted.GetRotation()));
+
+                // 멈추거나 움직이기 시작했을 때, 충돌 등으로 속도가 크게 바뀌었을 때
+                const bool bVelocityChanged =
+                    LinearVelocity.IsZero() != LastLinearVelocity.IsZero() ||
+                    AngularVelocity.IsZero() != LastAngularVelocity.IsZero() ||
+                    FVector::DistSquared(LinearVelocity, LastLinearVelocity) > FMath::Square(WorldVelocityThreshold) ||
+                    FVector::DistSquared(AngularVelocity, LastAngularVelocity) > FMath::Square(WorldVelocityThreshold);
+
+                // 움직이는 동안에는 예측이 맞아도 소유권이 풀리기 전에 다시 보냄
+                const bool bMoving = !LinearVelocity.IsZero() || !AngularVelocity.IsZero();
+                const bool bKeepOwnership = bMoving && Elapsed >= WorldOwnershipTimeout * 0.5f;
+
+                bSignificantChange = (DeltaLoc.Size() > WorldPosThreshold) || (AngleDeg > WorldRotThreshold) || bVelocityChanged || bKeepOwnership;
+
+                if (!bSignificantChange)
+                {
+                    // 임계값 미만: 지난 확인 이후에도 움직였으면 남겨 두고 다음 주기에 누적 변화로 다시 확인,
+                    // 그 사이 움직임이 없었으면 멈춘 것이므로 남은 차이를 마지막 상태로 보냄
+                    bStillMoving = WorldObjects.ConsumeMoved(Row);
+                    bSignificantChange = !bStillMoving &&
+                        (DeltaLoc.SizeSquared() > FMath::Square(WorldSleepPosTolerance) || AngleDeg > WorldSleepRotTolerance);
+                }
             }
 
             if (bSignificantChange)
             {
-                SendWorldObjectTransform(ObjectID, CurrentTransform);
-                LastSentTransforms.Add(ObjectID, CurrentTransform);
+                SendWorldObjectTransformByHandle(Handle, CurrentTransform, LinearVelocity, AngularVelocity, bOwnedByOther);
+                RecordWorldObjectSend(Row, CurrentTransform, LinearVelocity, AngularVelocity);
+            }
+
+            if (bStillMoving)
+            {
+                ++DirtyIndex;
+            }
+            else
+            {
+                WorldObjects.ClearDirty(DirtyIndex);
             }
         }
 
         TimeSinceLastWorldSend = 0.f;
     }
 
-    // 3) 월드 오브젝트 보간 처리
-    for (auto It = WorldObjectTargetTransforms.CreateIterator(); It; ++It)
-    {
-        const FString& ObjectID = It.Key();
-        const FTransform& TargetTransform = It.Value();
+    FlushOutboundBatch();
 
-        AActor** ActorPtr = RemoteWorldObjectsMap.Find(ObjectID);
-        if (ActorPtr && *ActorPtr)
+    // 3) 월드 오브젝트 보간 처리 (새 목표를 받아 깨어 있는 오브젝트만)
+    for (int32 ActiveIndex = 0; ActiveIndex < WorldObjects.ActiveHandles.Num();)
+    {
+        const int32 Row = WorldObjects.Find(WorldObjects.ActiveHandles[ActiveIndex]);
+        AActor* Actor = Row != INDEX_NONE ? WorldObjects.Actors[Row].Get() : nullptr;
+        if (!Actor)
         {
-            AActor* Actor = *ActorPtr;
-            float InterpSpeed = WorldObjectInterpSpeeds.Contains(ObjectID) ? WorldObjectInterpSpeeds[ObjectID] : 25.0f;
-
-            FVector NewLocation = FMath::VInterpTo(Actor->GetActorLocation(), TargetTransform.GetLocation(), DeltaTime, InterpSpeed);
-            FRotator NewRotation = FMath::RInterpTo(Actor->GetActorRotation(), TargetTransform.GetRotation().Rotator(), DeltaTime, InterpSpeed);
-
-            Actor->SetActorLocationAndRotation(NewLocation, NewRotation);
-
-            // 목표에 거의 도달했으면 맵에서 제거 (선택 사항: 불필요한 처리 방지)
-            if (Actor->GetActorLocation().Equals(TargetTransform.GetLocation(), 0.1f) &&
-                Actor->GetActorRotation().Equals(TargetTransform.GetRotation().Rotator(), 0.1f))
+            // 액터가 유효하지 않으면 행 제거 (활성 목록에서도 빠지고 마지막 항목이 이 자리로 오므로 ActiveIndex 유지)
+            if (Row != INDEX_NONE)
             {
-                // It.RemoveCurrent(); // 현재는 계속 보간하도록 유지
+                WorldObjects.RemoveAtSwap(Row);
             }
+            else
+            {
+                WorldObjects.ActiveHandles.RemoveAtSwap(ActiveIndex, EAllowShrinking::No);
+            }
+            continue;
         }
-        else
+
+        // 받은 속도로 목표를 외삽 (WorldMaxExtrapolationTime 이후에는 그 자리에서 다음 목표를 기다림)
+        const FVector& LinearVelocity = WorldObjects.LinearVelocities[Row];
+        const FVector& AngularVelocity = WorldObjects.AngularVelocities[Row];
+        const bool bMoving = !LinearVelocity.IsZero() || !AngularVelocity.IsZero();
+        const double Elapsed = FMath::Min(Now - WorldObjects.ReceiveTimes[Row], (double)WorldMaxExtrapolationTime);
+        const FTransform Goal = bMoving
+            ? ExtrapolateWorldObject(WorldObjects.TargetTransforms[Row], LinearVelocity, AngularVelocity, Elapsed)
+            : WorldObjects.TargetTransforms[Row];
+        const float InterpSpeed = WorldObjects.InterpSpeeds[Row];
+
+        FVector NewLocation = FMath::VInterpTo(Actor->GetActorLocation(), Goal.GetLocation(), DeltaTime, InterpSpeed);
+        FQuat NewRotation = FMath::QInterpTo(Actor->GetActorQuat(), Goal.GetRotation(), DeltaTime, InterpSpeed);
+
+        // 로컬에서 시뮬레이션 중인 바디는 재우면 아무도 바로잡지 않으므로, 소유자가 멈췄다고(속도 0) 보내거나
+        // 소유권이 풀릴 때까지는 외삽 한도를 넘겨도 깨워 두고 목표 쪽으로 계속 끌어당김
+        UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+        const bool bSimulating = Primitive && Primitive->IsSimulatingPhysics();
+        const bool bGoalSettled = !bMoving ||
+            (Elapsed >= WorldMaxExtrapolationTime && (!bSimulating || Now >= WorldObjects.OwnerExpireTimes[Row]));
+
+        // 목표가 더 움직이지 않고 충분히 가까워지면 정확히 맞추고 재움
+        const bool bArrived =
+            bGoalSettled &&
+            FVector::DistSquared(NewLocation, Goal.GetLocation()) <= FMath::Square(WorldSleepPosTolerance) &&
+            FMath::RadiansToDegrees(NewRotation.AngularDistance(Goal.GetRotation())) <= WorldSleepRotTolerance;
+        TGuardValue<bool> ApplyingRemote(bApplyingRemoteWorldTransform, true);
+        if (bArrived)
         {
-            // 액터가 유효하지 않으면 맵에서 제거
-            It.RemoveCurrent();
+            Actor->SetActorLocationAndRotation(Goal.GetLocation(), Goal.GetRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+            // 받은 속도가 남아 있으면 잠든 뒤 로컬 물리가 계속 움직여 소유권이 풀린 뒤 어긋난 결과를 보내게 됨
+            if (bSimulating)
+            {
+                Primitive->SetPhysicsLinearVelocity(FVector::ZeroVector);
+                Primitive->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+            }
+            // 서버가 이미 가진 상태이므로 되돌려 보내지 않도록 기준으로 삼음
+            WorldObjects.LastSentTransforms[Row] = Goal;
+            WorldObjects.LastSentLinearVelocities[Row] = FVector::ZeroVector;
+            WorldObjects.LastSentAngularVelocities[Row] = FVector::ZeroVector;
+            WorldObjects.LastSentTimes[Row] = Now;
+            WorldObjects.Flags[Row] |= EPknuWorldObjectFlags::HasLastSent;
+            WorldObjects.Sleep(ActiveIndex);
+            continue;
         }
+
+        Actor->SetActorLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::TeleportPhysics);
+        ++ActiveIndex;
     }
 }
 
@@ -894,94 +1313,262 @@ void UWebSocketManager::SendInitialWorldObjects()
 {
     if (!World || !WebSocket.IsValid() || !WebSocket->IsConnected()) return;
 
-    for (TActorIterator<AActor> It(World); It; ++It)
+    // 색인에는 "WorldObject" 태그가 있는 액터만 있음
+    WorldObjectIndex.Bind(World);
+    WorldObjectIndex.ForEach([this](AActor* Actor)
     {
-        AActor* Actor = *It;
-        if (!Actor) continue;
-
-        // 태그 필터링: "WorldObject" 태그가 있어야 전송
-        if (!Actor->ActorHasTag(FName(TEXT("WorldObject")))) continue;
-
         FString ObjectID = Actor->GetName();
         FTransform Transform = Actor->GetActorTransform();
 
-        // 트래킹 맵에 추가 (초기 상태 기준)
-        TrackedWorldObjects.Add(ObjectID, Actor);
-        LastSentTransforms.Add(ObjectID, Transform);
+        // 트래킹 맵에 추가 (초기 상태 기준). 서버 핸들은 이 update 에 대한 handle_map 으로 연결됨
+        const FPknuEntityHandle Handle = Handles.FindOrAdd(ObjectID);
+        const int32 Row = WorldObjects.FindOrAdd(Handle);
+        WorldObjects.Actors[Row] = Actor;
+        WorldObjects.LastSentTransforms[Row] = Transform;
+        if (!WorldObjects.HasFlags(Row, EPknuWorldObjectFlags::Tracked))
+        {
+            WorldObjects.Flags[Row] |= EPknuWorldObjectFlags::Tracked;
+            WatchTrackedWorldObject(Row);
+        }
+        WorldObjects.Flags[Row] |= EPknuWorldObjectFlags::HasLastSent;
 
         // 서버로 전송 (update 메시지)
-        TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-        Root->SetStringField(TEXT("type"), TEXT("update"));
-        Root->SetStringField(TEXT("entityType"), TEXT("world"));
-        Root->SetStringField(TEXT("id"), ObjectID);
+        WriteWorldObjectUpdateJson(ObjectID, Transform, FVector::ZeroVector, FVector::ZeroVector, false);
+        WebSocket->Send(JsonWriter.GetOutput());
 
-        FVector Loc = Transform.GetLocation();
-        FRotator Rot = Transform.GetRotation().Rotator();
+        // UE_LOG(LogTemp, Warning, TEXT("[SEND INITIAL WORLD OBJECT] %s"), *ObjectID);
+    });
+}
 
-        TSharedPtr<FJsonObject> Pos = MakeShared<FJsonObject>();
-        Pos->SetNumberField(TEXT("x"), Loc.X);
-        Pos->SetNumberField(TEXT("y"), Loc.Y);
-        Pos->SetNumberField(TEXT("z"), Loc.Z);
 
-        TSharedPtr<FJsonObject> RotObj = MakeShared<FJsonObject>();
-        RotObj->SetNumberField(TEXT("pitch"), Rot.Pitch);
-        RotObj->SetNumberField(TEXT("yaw"), Rot.Yaw);
-        RotObj->SetNumberField(TEXT("roll"), Rot.Roll);
+void UWebSocketManager::WatchTrackedWorldObject(int32 Row)
+{
+    AActor* Actor = WorldObjects.Actors[Row].Get();
+    USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr;
+    if (!Root) return;
 
-        TSharedPtr<FJsonObject> State = MakeShared<FJsonObject>();
-        State->SetObjectField(TEXT("position"), Pos);
-        State->SetObjectField(TEXT("rotation"), RotObj);
+    // 물리 시뮬레이션 중인 바디도 움직일 때마다 컴포넌트 Transform 이 갱신되므로 같은 알림으로 충분 (잠들면 알림도 멈춤)
+    const FPknuEntityHandle Handle = WorldObjects.Handles[Row];
+    Root->TransformUpdated.AddWeakLambda(this, [this, Handle](USceneComponent*, EUpdateTransformFlags, ETeleportType)
+    {
+        OnTrackedWorldObjectMoved(Handle);
+    });
+}
 
-        Root->SetObjectField(TEXT("state"), State);
-        Root->SetBoolField(TEXT("isObject"), true);
+void UWebSocketManager::OnTrackedWorldObjectMoved(FPknuEntityHandle Handle)
+{
+    if (bApplyingRemoteWorldTransform) return;
 
-        FString OutString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutString);
-        FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+    const int32 Row = WorldObjects.Find(Handle);
+    if (Row != INDEX_NONE)
+    {
+        WorldObjects.MarkDirty(Row);
+    }
+}
 
-        WebSocket->Send(OutString);
+void UWebSocketManager::OnOwnerCharacterHit(AActor* SelfActor, AActor* OtherActor, FVector NormalImpulse, const FHitResult& Hit)
+{
+    if (!OtherActor || !OtherActor->ActorHasTag(FPknuWorldObjectIndex::WorldObjectTag)) return;
 
-        // UE_LOG(LogTemp, Warning, TEXT("[SEND INITIAL WORLD OBJECT] %s"), *ObjectID);
+    const int32 Row = WorldObjects.Find(Handles.Find(OtherActor->GetName()));
+    if (Row != INDEX_NONE)
+    {
+        WorldObjects.LastPushTimes[Row] = FPknuClockSync::LocalNow();
     }
 }
 
-
 void UWebSocketManager::SendWorldObjectTransform(const FString& ObjectID, const FTransform& Transform)
 {
-    if (!WebSocket.IsValid() || !WebSocket->IsConnected()) return;
+    // 게임 코드가 직접 옮긴 위치이므로 소유권을 요청
+    SendWorldObjectTransformByHandle(Handles.FindOrAdd(ObjectID), Transform, FVector::ZeroVector, FVector::ZeroVector, true);
+}
 
-    TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-    Root->SetStringField(TEXT("type"), TEXT("update"));
-    Root->SetStringField(TEXT("entityType"), TEXT("world"));
-    Root->SetStringField(TEXT("id"), ObjectID);
+void UWebSocketManager::RecordWorldObjectSend(int32 Row, const FTransform& Transform, const FVector& LinearVelocity, const FVector& AngularVelocity)
+{
+    WorldObjects.LastSentTransforms[Row] = Transform;
+    WorldObjects.LastSentLinearVelocities[Row] = LinearVelocity;
+    WorldObjects.LastSentAngularVelocities[Row] = AngularVelocity;
+    WorldObjects.LastSentTimes[Row] = FPknuClockSync::LocalNow();
+    WorldObjects.Flags[Row] |= EPknuWorldObjectFlags::HasLastSent;
+}
 
-    FVector Loc = Transform.GetLocation();
-    FRotator Rot = Transform.GetRotation().Rotator();
+void UWebSocketManager::SetWorldObjectOwner(int32 Row, uint32 OwnerWireHandle)
+{
+    WorldObjects.OwnerHandles[Row] = OwnerWireHandle;
+    WorldObjects.OwnerExpireTimes[Row] = FPknuClockSync::LocalNow() + WorldOwnershipTimeout;
+}
 
-    TSharedPtr<FJsonObject> Pos = MakeShared<FJsonObject>();
-    Pos->SetNumberField(TEXT("x"), Loc.X);
-    Pos->SetNumberField(TEXT("y"), Loc.Y);
-    Pos->SetNumberField(TEXT("z"), Loc.Z);
+void UWebSocketManager::SendWorldObjectTransformByHandle(FPknuEntityHandle Handle, const FTransform& Transform,
+    const FVector& LinearVelocity, const FVector& AngularVelocity, bool bClaim)
+{
+    if (!WebSocket.IsValid() || !WebSocket->IsConnected() || !Handle.IsValid()) return;
 
-    TSharedPtr<FJsonObject> RotObj = MakeShared<FJsonObject>();
-    RotObj->SetNumberField(TEXT("pitch"), Rot.Pitch);
-    RotObj->SetNumberField(TEXT("yaw"), Rot.Yaw);
-    RotObj->SetNumberField(TEXT("roll"), Rot.Roll);
+    const uint32 WireHandle = Handles.GetWireHandle(Handle);
+    if (bUseBinaryProtocol && WireHandle != 0)
+    {
+        FPknuDeltaFrame Frame;
+        Frame.WireHandle = WireHandle;
+        Frame.State.Transform = Quantizer.Quantize(Transform.GetLocation(), Transform.GetRotation());
+        DeltaChannels.FindOrAdd(Handle).Prepare(Frame.State, DeltaKeyframeInterval, Frame.Seq, Frame.Baseline, Frame.FieldMask);
+        Frame.LinearVelocity = LinearVelocity;
+        Frame.AngularVelocity = AngularVelocity;
+        Frame.bClaim = bClaim;
+
+        FPknuBinaryProtocol::EncodeDelta(BinarySendBuffer, EPknuBinaryMessage::WorldTransform, Frame, Quantizer);
+        SendBinaryFrame(BinarySendBuffer);
+        return;
+    }
 
-    TSharedPtr<FJsonObject> State = MakeShared<FJsonObject>();
-    State->SetObjectField(TEXT("position"), Pos);
-    State->SetObjectField(TEXT("rotation"), RotObj);
+    WriteWorldObjectUpdateJson(Handles.GetName(Handle), Transform, LinearVelocity, AngularVelocity, bClaim);
+    SendJsonFrame(JsonWriter.GetOutput());
 
-    Root->SetObjectField(TEXT("state"), State);
-    Root->SetBoolField(TEXT("isObject"), true);
+    // UE_LOG(LogTemp, Warning, TEXT("[SEND WORLD OBJECT TRANSFORM] %s"), *Handles.GetName(Handle));
+}
 
-    FString OutString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutString);
-    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+void UWebSocketManager::BeginOutboundBatch()
+{
+    bBatchingOutbound = true;
+    BinaryBatchCount = 0;
+    JsonBatchCount = 0;
+}
 
-    WebSocket->Send(OutString);
+void UWebSocketManager::FlushOutboundBatch()
+{
+    bBatchingOutbound = false;
+    FlushBinaryBatch();
+    FlushJsonBatch();
+}
 
-    // UE_LOG(LogTemp, Warning, TEXT("[SEND WORLD OBJECT TRANSFORM] %s"), *ObjectID);
+void UWebSocketManager::SendJsonFrame(const FString& Json)
+{
+    if (!bBatchingOutbound)
+    {
+        WebSocket->Send(Json);
+        return;
+    }
+
+    if (JsonBatchCount == 0)
+    {
+        JsonBatchMessages.Reset();
+    }
+    else
+    {
+        JsonBatchMessages.AppendChar(TEXT(','));
+    }
+    JsonBatchMessages.Append(Json);
+    ++JsonBatchCount;
+}
+
+void UWebSocketManager::SendBinaryFrame(const TArray<uint8>& Frame)
+{
+    if (!bBatchingOutbound)
+    {
+        WebSocket->Send(Frame.GetData(), Frame.Num(), true);
+        return;
+    }
+
+    // Count 는 uint8 이므로 가득 차면 먼저 내보냄
+    if (BinaryBatchCount == FPknuBinaryProtocol::MaxBatchCount)
+    {
+        FlushBinaryBatch();
+    }
+    if (BinaryBatchCount == 0)
+    {
+        FPknuBinaryProtocol::BeginBatch(BinaryBatchBuffer);
+    }
+    FPknuBinaryProtocol::AppendToBatch(BinaryBatchBuffer, Frame);
+    ++BinaryBatchCount;
+}
+
+void UWebSocketManager::FlushJsonBatch()
+{
+    if (JsonBatchCount == 0) return;
+
+    if (JsonBatchCount == 1)
+    {
+        // 하나뿐이면 감싸지 않고 그대로
+        WebSocket->Send(JsonBatchMessages);
+    }
+    else
+    {
+        JsonBatchFrame.Reset();
+        JsonBatchFrame.Append(TEXT("{\"type\":\"batch\",\"messages\":["));
+        JsonBatchFrame.Append(JsonBatchMessages);
+        JsonBatchFrame.Append(TEXT("]}"));
+        WebSocket->Send(JsonBatchFrame);
+    }
+    JsonBatchCount = 0;
+}
+
+void UWebSocketManager::FlushBinaryBatch()
+{
+    if (BinaryBatchCount == 0) return;
+
+    if (BinaryBatchCount == 1)
+    {
+        // 하나뿐이면 Batch 헤더(Kind, Count, Length)를 떼고 원래 프레임만 전송
+        constexpr int32 HeaderSize = 4;
+        WebSocket->Send(BinaryBatchBuffer.GetData() + HeaderSize, BinaryBatchBuffer.Num() - HeaderSize, true);
+    }
+    else
+    {
+        FPknuBinaryProtocol::FinishBatch(BinaryBatchBuffer, BinaryBatchCount);
+        WebSocket->Send(BinaryBatchBuffer.GetData(), BinaryBatchBuffer.Num(), true);
+    }
+    BinaryBatchCount = 0;
+}
+
+FPknuEntityHandle UWebSocketManager::ResolveHandle(uint32 WireHandle, const FString& Name)
+{
+    if (WireHandle != 0)
+    {
+        const FPknuEntityHandle Handle = Handles.FindByWire(WireHandle);
+        if (Handle.IsValid()) return Handle;
+        // handle_map 을 놓친 경우 메시지에 함께 온 이름으로 연결
+        if (!Name.IsEmpty()) return Handles.BindWire(WireHandle, Name);
+    }
+    return Name.IsEmpty() ? FPknuEntityHandle() : Handles.FindOrAdd(Name);
+}
+
+void UWebSocketManager::WriteWorldObjectUpdateJson(const FString& ObjectID, const FTransform& Transform, const FVector& LinearVelocity, const FVector& AngularVelocity, bool bClaim)
+{
+    FVector Loc = Transform.GetLocation();
+    FRotator Rot = Transform.GetRotation().Rotator();
+
+    JsonWriter.BeginObject();
+    JsonWriter.WriteString(TEXT("type"), TEXT("update"));
+    JsonWriter.WriteString(TEXT("entityType"), TEXT("world"));
+    JsonWriter.WriteString(TEXT("id"), ObjectID);
+
+    JsonWriter.BeginObject(TEXT("state"));
+    JsonWriter.BeginObject(TEXT("position"));
+    JsonWriter.WriteNumber(TEXT("x"), Loc.X);
+    JsonWriter.WriteNumber(TEXT("y"), Loc.Y);
+    JsonWriter.WriteNumber(TEXT("z"), Loc.Z);
+    JsonWriter.EndObject();
+    JsonWriter.BeginObject(TEXT("rotation"));
+    JsonWriter.WriteNumber(TEXT("pitch"), Rot.Pitch);
+    JsonWriter.WriteNumber(TEXT("yaw"), Rot.Yaw);
+    JsonWriter.WriteNumber(TEXT("roll"), Rot.Roll);
+    JsonWriter.EndObject();
+    JsonWriter.BeginObject(TEXT("velocity"));
+    JsonWriter.WriteNumber(TEXT("x"), LinearVelocity.X);
+    JsonWriter.WriteNumber(TEXT("y"), LinearVelocity.Y);
+    JsonWriter.WriteNumber(TEXT("z"), LinearVelocity.Z);
+    JsonWriter.EndObject();
+    JsonWriter.BeginObject(TEXT("angularVelocity"));
+    JsonWriter.WriteNumber(TEXT("x"), AngularVelocity.X);
+    JsonWriter.WriteNumber(TEXT("y"), AngularVelocity.Y);
+    JsonWriter.WriteNumber(TEXT("z"), AngularVelocity.Z);
+    JsonWriter.EndObject();
+    JsonWriter.EndObject();
+
+    JsonWriter.WriteBool(TEXT("isObject"), true);
+    if (bClaim)
+    {
+        JsonWriter.WriteBool(TEXT("claim"), true);
+    }
+    JsonWriter.EndObject();
 }
 
 TStatId UWebSocketManager::GetStatId() const
@@ -3,13 +3,36 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "IWebSocket.h"
+#include "Engine/HitResult.h"
+#include "TransformQuantization.h"
+#include "DeltaCompression.h"
+#include "BinaryProtocol.h"
+#include "PknuJsonWriter.h"
+#include "PknuJsonPullParser.h"
+#include "EntityHandleTable.h"
+#include "PknuClockSync.h"
+#include "WorldObjectIndex.h"
+#include "WorldObjectTable.h"
 #include "WebSocketManager.generated.h"
 
 class AMyWebSocketCharacter;
 class AMyRemoteCharacter;
+class UWebSocketManager;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInitialStateSynced);
 
+// 수신 텍스트 메시지 핸들러와 호출 통계 (UWebSocketManager::RegisterInboundRoutes)
+using FPknuInboundHandler = void (UWebSocketManager::*)(const FPknuInboundMessage&);
+
+struct FPknuInboundRoute
+{
+    FString Type;
+    FString Action;
+    FPknuInboundHandler Handler = nullptr;
+    uint64 CallCount = 0;
+    uint64 Cycles = 0; // FPlatformTime::Cycles64 누적
+};
+
 UCLASS(Blueprintable)
 class PROJECT_PKNU_API UWebSocketManager : public UObject, public FTickableGameObject
 {
@@ -19,19 +42,6 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "WebSocket")
     FOnInitialStateSynced OnInitialStateSynced;
 
-    UPROPERTY()
-    TMap<FString, TWeakObjectPtr<AActor>> TrackedWorldObjects; // ObjectID -> Actor (Weak Ptr)
-
-    UPROPERTY()
-    TMap<FString, FTransform> LastSentTransforms; // ObjectID -> 마지막 전송 Transform
-
-    UPROPERTY()
-    TMap<FString, FTransform> WorldObjectTargetTransforms; // 월드 오브젝트의 목표 Transform
-    UPROPERTY()
-    TMap<FString, float> WorldObjectInterpSpeeds; // 월드 오브젝트별 보간 속도
-    UPROPERTY()
-    TMap<FString, double> WorldObjectLastReceiveTime; // 월드 오브젝트의 마지막 업데이트 수신 시간
-
     UWebSocketManager();
 
     void Initialize(UClass* InRemoteCharacterClass, UWorld* InWorld);
@@ -44,7 +54,7 @@ public:
 
     // 메시지 전송
     void SendRegisterCharacter(); // 캐릭터 등록
-    void SendUpdate(const FString& EntityType, const FString& ID, const FTransform& Transform, float Speed, bool bIsFalling);
+    void SendUpdate(const FString& EntityType, FPknuEntityHandle Handle, const FTransform& Transform, float Speed, bool bIsFalling);
     void SendChatMessage(const FString& Message); // 채팅 메시지 전송
     void SendTransformData(); // 초기 Transform 전송
 
@@ -54,6 +64,10 @@ public:
 
     // 수신 메시지 처리
     void OnWebSocketMessage(const FString& Message);
+    void OnWebSocketBinaryMessage(const void* Data, SIZE_T Size, bool bIsLastFragment);
+
+    // 수신 핸들러별 호출 횟수 / 누적 시간 로그 (콘솔: Pknu.Net.DumpHandlerStats [reset])
+    void DumpInboundStats(bool bReset);
 
     UFUNCTION()
     void SendInitialWorldObjects();
@@ -62,6 +76,10 @@ public:
     void SendWorldObjectTransform(const FString& ObjectID, const FTransform& Transform);
 
 
+    // 로컬에서 움직인 월드 오브젝트를 확인 / 전송하는 주기 (플레이어 전송 주기 SendInterval 과 별개)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects", meta = (ClampMin = "0"))
+    float WorldSendInterval = 0.3f; // s
+
     // 임계값 (조정 가능)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
     float WorldPosThreshold = 15.0f; // cm 단위: 위치 변화가 이보다 커야 전송
@@ -69,12 +87,116 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
     float WorldRotThreshold = 15.0f; // degree: 회전 변화가 이보다 커야 전송
 
+    // 받은 목표와 이만큼 가까워지면 목표 위치로 맞추고 보간을 멈춤 (다음 목표가 올 때까지)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldSleepPosTolerance = 0.5f; // cm
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldSleepRotTolerance = 0.5f; // degree
+
+    // 받은 속도로 목표를 외삽하는 최대 시간. 이후에는 다음 목표가 올 때까지 멈춰 있음 (송신 쪽 추측 항법도 같은 값 사용)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldMaxExtrapolationTime = 0.5f; // s
+
+    // 마지막으로 보낸 속도와 이만큼 달라지면 위치 오차와 관계없이 전송 (충돌 직후 등)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldVelocityThreshold = 50.0f; // cm/s
+
+    // 이보다 느린 속도는 멈춘 것으로 보고 0 으로 보냄 (받는 쪽이 미세한 속도로 계속 외삽하지 않도록)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldRestSpeed = 5.0f; // cm/s, deg/s
+
+    // 소유자에게서 이 시간 동안 소식이 없으면 소유권이 풀린 것으로 봄 (server_code.js OWNERSHIP_TIMEOUT_MS 와 같게)
+    // 소유자는 움직이는 동안 절반 주기마다 변화가 없어도 다시 보내 소유권을 유지
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldOwnershipTimeout = 1.0f; // s
+
+    // 내 캐릭터가 부딪힌 뒤 이 시간 동안은 다른 클라이언트가 소유한 오브젝트도 소유권을 요청(claim)하며 전송
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|WorldObjects")
+    float WorldPushClaimWindow = 0.5f; // s
+
     // (선택) 월드 오브젝트 전송 전용 타이머 (플레이어 전송과 분리)
     float TimeSinceLastWorldSend = 0.0f;
 
+    // Transform 양자화 설정 (hello 로 서버에 제안, 서버가 확정한 값은 hello_ack 로 수신)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|Quantization", meta = (ClampMin = "8", ClampMax = "30"))
+    int32 PositionQuantizationBits = 20;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|Quantization", meta = (ClampMin = "6", ClampMax = "10"))
+    int32 RotationQuantizationBits = 10;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|Quantization")
+    float QuantizationBoundsPadding = 10000.0f; // cm: 레벨 경계 바깥 여유 공간
+
+    // 델타 전송 시 이 횟수마다 전체 상태(키프레임)를 보냄 (손실 복구용)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network|Delta", meta = (ClampMin = "1"))
+    int32 DeltaKeyframeInterval = 20;
+
+    const FTransformQuantizer& GetQuantizer() const { return Quantizer; }
+
 protected:
-    void SpawnOrUpdateWorldObject(const FString& ObjectID, const FTransform& Transform, bool bIsLocalUpdate);
-    void SpawnOrUpdateRemoteCharacter(const FString& PlayerID, const FTransform& Transform, float Speed, bool bIsFalling, const FString& InPlayerName, double Timestamp);
+    // OwnerWireHandle 은 update_batch 의 src (0 이면 소유자 정보 없음)
+    void SpawnOrUpdateWorldObject(FPknuEntityHandle Handle, const FTransform& Transform, bool bIsLocalUpdate,
+        const FVector& LinearVelocity = FVector::ZeroVector, const FVector& AngularVelocity = FVector::ZeroVector, uint32 OwnerWireHandle = 0);
+    void SpawnOrUpdateRemoteCharacter(FPknuEntityHandle Handle, const FTransform& Transform, float Speed, bool bIsFalling, const FString& InPlayerName, double Timestamp);
+
+    // SendWorldObjectTransform 의 핸들 버전 (Tick 등 내부 경로용)
+    void SendWorldObjectTransformByHandle(FPknuEntityHandle Handle, const FTransform& Transform,
+        const FVector& LinearVelocity, const FVector& AngularVelocity, bool bClaim);
+    // 보낸 상태를 추측 항법 기준으로 남김 (소유권은 바꾸지 않음)
+    void RecordWorldObjectSend(int32 Row, const FTransform& Transform, const FVector& LinearVelocity, const FVector& AngularVelocity);
+    // 서버가 update_batch 의 src 로 알려 준 소유자만 기록 (claim 이 거절되어도 서버는 ack 하므로 보낸 것만으로는 알 수 없음)
+    void SetWorldObjectOwner(int32 Row, uint32 OwnerWireHandle);
+
+    // Tracked 오브젝트의 루트 컴포넌트 TransformUpdated 에 연결 (움직였을 때만 전송 확인 대상이 됨)
+    void WatchTrackedWorldObject(int32 Row);
+    void OnTrackedWorldObjectMoved(FPknuEntityHandle Handle);
+
+    // 내 캐릭터가 부딪힌 월드 오브젝트는 WorldPushClaimWindow 동안 소유권을 요청
+    UFUNCTION()
+    void OnOwnerCharacterHit(AActor* SelfActor, AActor* OtherActor, FVector NormalImpulse, const FHitResult& Hit);
+    // 받은 Transform 을 적용하는 동안에는 움직임 알림을 로컬 이동으로 보지 않음
+    bool bApplyingRemoteWorldTransform = false;
+
+    // 서버 핸들("h")이 있으면 배열 조회만, 없으면(구버전 서버) 이름으로 로컬 핸들을 찾거나 할당
+    FPknuEntityHandle ResolveHandle(uint32 WireHandle, const FString& Name);
+
+    // 바이너리 프로토콜 협상 (접속 직후 hello 전송, hello_ack 수신 시 활성화)
+    void SendHello();
+    void ApplyQuantizer(const FTransformQuantizer& InQuantizer);
+
+    // 시계 동기화 (ping 은 Tick 에서 ClockSync 가 정한 간격으로 전송)
+    void SendPing();
+    // 송신 시각(서버 시계 ms) -> 스냅샷 시각(FPknuClockSync::LocalNow 기준). 동기화 전이거나 ts 가 없으면 도착 시각
+    double ToSnapshotTime(double SenderTimestampMs) const;
+
+    // 수신 텍스트 메시지 핸들러 (RegisterInboundRoutes 에서 (type, action) 에 등록)
+    void HandleHelloAck(const FPknuInboundMessage& Msg);
+    void HandlePong(const FPknuInboundMessage& Msg);
+    void HandleHandleMap(const FPknuInboundMessage& Msg);
+    void HandleId(const FPknuInboundMessage& Msg);
+    void HandleStateSync(const FPknuInboundMessage& Msg);
+    // 압축 청크 state_sync: 도착하는 대로 적용하고 ack (마지막 청크에서 OnInitialStateSynced)
+    void HandleStateChunk(const uint8* Data, int32 Size);
+    void ApplyStateSyncEntities(const FPknuInboundMessage& Msg);
+    void HandleWorldObjectUpdate(const FPknuInboundMessage& Msg);
+    void HandleCharacterState(const FPknuInboundMessage& Msg);
+    void HandleRemoveCharacter(const FPknuInboundMessage& Msg);
+    void HandleNewChat(const FPknuInboundMessage& Msg);
+    void HandleUpdateBatch(const FPknuInboundMessage& Msg);
+    void ApplyBinaryUpdateBatch();
+    void HandlePlayerTransform(const FPknuInboundMessage& Msg);
+
+    // 송신 배칭: Begin 이후의 SendUpdate / 월드 오브젝트 전송은 Flush 때 한 프레임(batch)으로 나감
+    void BeginOutboundBatch();
+    void FlushOutboundBatch();
+    void SendJsonFrame(const FString& Json);
+    void SendBinaryFrame(const TArray<uint8>& Frame);
+    void FlushJsonBatch();
+    void FlushBinaryBatch();
+
+    // world 'update' 메시지를 JsonWriter 에 작성 (SendInitialWorldObjects / SendWorldObjectTransform 공용)
+    void WriteWorldObjectUpdateJson(const FString& ObjectID, const FTransform& Transform, const FVector& LinearVelocity, const FVector& AngularVelocity, bool bClaim);
 
 protected:
     TSharedPtr<IWebSocket> WebSocket;
@@ -82,8 +204,14 @@ protected:
     UWorld* World;
     AMyWebSocketCharacter* OwnerCharacter;
 
-    TMap<FString, AMyRemoteCharacter*> OtherPlayersMap; // Remote players
-    TMap<FString, AActor*> RemoteWorldObjectsMap;      // Remote/world objects
+    TMap<FPknuEntityHandle, AMyRemoteCharacter*> OtherPlayersMap; // Remote players
+    // 월드 오브젝트 복제 상태 (액터 / 마지막 전송 / 목표 Transform 등). 엔티티 맵은 모두 Handles 의 로컬 핸들을 키로 사용
+    FPknuWorldObjectTable WorldObjects;
+    // 처음 보는 ObjectID 를 찾을 때 쓰는 "WorldObject" 태그 액터 이름 색인 (World 에 바인딩)
+    FPknuWorldObjectIndex WorldObjectIndex;
+
+    // 엔티티 이름 <-> 핸들 (서버가 handle_map 으로 알려 준 핸들 포함)
+    FPknuEntityHandleTable Handles;
 
     // 이전 위치/회전/상태 비교용
     FVector LastSentLocation;
@@ -97,5 +225,51 @@ protected:
     float TimeSinceLastSend;
 
     FString MyPlayerId; // Client-generated unique ID
+    FPknuEntityHandle MyHandle; // MyPlayerId 의 핸들 ('id' 수신 시 설정)
     FString MyPlayerName; // Player's chosen name
+
+    // JSON 송신용 재사용 작성기 (메시지마다 FJsonObject 트리를 만들지 않음)
+    FPknuJsonWriter JsonWriter;
+
+    // 수신 텍스트 메시지 디코딩 결과 (메시지마다 Reset 후 재사용)
+    FPknuInboundMessage Inbound;
+
+    // 수신 디스패치 테이블: (type, action) 해시 -> InboundRoutes 인덱스
+    TArray<FPknuInboundRoute> InboundRoutes;
+    TMap<uint32, int32> InboundRouteIndex;
+
+    static uint32 MakeInboundRouteKey(FStringView Type, FStringView Action);
+    void RegisterInboundRoutes();
+    void RegisterInboundRoute(const TCHAR* Type, const TCHAR* Action, FPknuInboundHandler Handler);
+    FPknuInboundRoute* FindInboundRoute(FStringView Type, FStringView Action);
+
+    // 바이너리 프로토콜
+    bool bUseBinaryProtocol = false;  // 서버가 hello_ack 로 같은 버전을 확인해 준 경우에만 true
+    TArray<uint8> BinarySendBuffer;    // 송신용 재사용 버퍼
+    TArray<uint8> BinaryReceiveBuffer; // 분할 수신된 바이너리 프레임 조립용
+
+    // 송신 배칭 상태 (버퍼는 틱마다 재사용)
+    bool bBatchingOutbound = false;
+    TArray<uint8> BinaryBatchBuffer;
+    int32 BinaryBatchCount = 0;
+    FString JsonBatchMessages; // 쉼표로 이어 붙인 메시지 JSON
+    FString JsonBatchFrame;
+    int32 JsonBatchCount = 0;
+
+    // 와이어와 원격 캐릭터 스냅샷 버퍼가 공유하는 양자화 파라미터
+    FTransformQuantizer Quantizer;
+
+    // 서버 시계와 로컬 시계의 offset / drift (송신 ts 와 수신 스냅샷 시각 변환에 사용)
+    FPknuClockSync ClockSync;
+
+    // 엔티티별 델타 송신 채널 (서버 ack 기준 baseline)
+    TMap<FPknuEntityHandle, FDeltaSendChannel> DeltaChannels;
+    TArray<FPknuAckEntry> AckScratch;
+    // UpdateBatch 디코딩 결과 (프레임마다 재사용)
+    TArray<FPknuBinaryTransform> UpdateBatchPlayers;
+    TArray<FPknuBinaryTransform> UpdateBatchObjects;
+
+    // StateChunk 압축 해제 / 변환 버퍼 (청크마다 재사용)
+    TArray<uint8> StateChunkUtf8;
+    FString StateChunkText;
 };
@@ -0,0 +1,113 @@
+#include "WorldObjectIndex.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+
+const FName FPknuWorldObjectIndex::WorldObjectTag(TEXT("WorldObject"));
+
+void FPknuWorldObjectIndex::Bind(UWorld* InWorld)
+{
+    if (IsBoundTo(InWorld)) return;
+
+    Unbind();
+    if (!InWorld) return;
+
+    BoundWorld = InWorld;
+    for (TActorIterator<AActor> It(InWorld); It; ++It)
+    {
+        AddActor(*It);
+    }
+
+    ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FPknuWorldObjectIndex::OnActorSpawned));
+    ActorDestroyedHandle = InWorld->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FPknuWorldObjectIndex::OnActorDestroyed));
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FPknuWorldObjectIndex::OnLevelAdded);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FPknuWorldObjectIndex::OnLevelRemoved);
+}
+
+void FPknuWorldObjectIndex::Unbind()
+{
+    if (UWorld* World = BoundWorld.Get())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle); // 엔진 API 이름 그대로
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+    ActorSpawnedHandle.Reset();
+    ActorDestroyedHandle.Reset();
+    LevelAddedHandle.Reset();
+    LevelRemovedHandle.Reset();
+    BoundWorld.Reset();
+    Actors.Reset();
+}
+
+AActor* FPknuWorldObjectIndex::Find(const FString& ObjectID) const
+{
+    // 이름표에 없는 이름이면 그런 이름의 액터도 없음
+    const FName ObjectName(*ObjectID, FNAME_Find);
+    return ObjectName.IsNone() ? nullptr : Find(ObjectName);
+}
+
+AActor* FPknuWorldObjectIndex::Find(FName ObjectName) const
+{
+    const TWeakObjectPtr<AActor>* Found = Actors.Find(ObjectName);
+    return Found ? Found->Get() : nullptr;
+}
+
+void FPknuWorldObjectIndex::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || !Actor->ActorHasTag(WorldObjectTag)) return;
+
+    Actors.Add(Actor->GetFName(), Actor);
+}
+
+void FPknuWorldObjectIndex::RemoveActor(AActor* Actor)
+{
+    if (!Actor) return;
+
+    // 같은 이름의 다른 액터가 이미 자리를 차지했으면 그대로 둠
+    const FName ObjectName = Actor->GetFName();
+    const TWeakObjectPtr<AActor>* Found = Actors.Find(ObjectName);
+    if (Found && (!Found->IsValid() || Found->Get() == Actor))
+    {
+        Actors.Remove(ObjectName);
+    }
+}
+
+void FPknuWorldObjectIndex::OnActorSpawned(AActor* Actor)
+{
+    AddActor(Actor);
+}
+
+void FPknuWorldObjectIndex::OnActorDestroyed(AActor* Actor)
+{
+    RemoveActor(Actor);
+}
+
+void FPknuWorldObjectIndex::OnLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+    if (!Level || !IsBoundTo(InWorld)) return;
+
+    for (AActor* Actor : Level->Actors)
+    {
+        AddActor(Actor);
+    }
+}
+
+void FPknuWorldObjectIndex::OnLevelRemoved(ULevel* Level, UWorld* InWorld)
+{
+    if (!IsBoundTo(InWorld)) return;
+
+    // Level 이 null 이면 월드 전체가 정리되는 중
+    if (!Level)
+    {
+        Actors.Reset();
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        RemoveActor(Actor);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/**
+ * "WorldObject" 태그가 붙은 액터의 이름(FName) -> 액터 색인.
+ *
+ * 처음 보는 ObjectID 마다 월드 전체를 TActorIterator 로 훑고 GetName() 문자열을 비교하면
+ * add_object 묶음이나 state_sync 한 번이 O(오브젝트 x 액터) 가 되므로, Bind 때 한 번만 훑어 색인을 만들고
+ * 이후에는 액터 스폰 / 파괴, 레벨 스트리밍 추가 / 제거 콜백으로 갱신한다.
+ * 이름표에 없는 이름은 FName 생성 없이 (FNAME_Find) 바로 실패한다.
+ */
+class PROJECT_PKNU_API FPknuWorldObjectIndex
+{
+public:
+    static const FName WorldObjectTag;
+
+    FPknuWorldObjectIndex() = default;
+    ~FPknuWorldObjectIndex() { Unbind(); }
+
+    FPknuWorldObjectIndex(const FPknuWorldObjectIndex&) = delete;
+    FPknuWorldObjectIndex& operator=(const FPknuWorldObjectIndex&) = delete;
+
+    // InWorld 의 액터로 색인을 다시 만들고 콜백을 등록 (이미 같은 월드면 아무것도 하지 않음)
+    void Bind(UWorld* InWorld);
+    void Unbind();
+    bool IsBoundTo(const UWorld* InWorld) const { return InWorld && BoundWorld.Get() == InWorld; }
+
+    AActor* Find(const FString& ObjectID) const;
+    AActor* Find(FName ObjectName) const;
+
+    // 색인된 액터 순회 (파괴된 항목은 건너뜀)
+    template <typename FunctorType>
+    void ForEach(FunctorType&& Func) const
+    {
+        for (const TPair<FName, TWeakObjectPtr<AActor>>& Pair : Actors)
+        {
+            if (AActor* Actor = Pair.Value.Get())
+            {
+                Func(Actor);
+            }
+        }
+    }
+
+    int32 Num() const { return Actors.Num(); }
+
+private:
+    void AddActor(AActor* Actor);
+    void RemoveActor(AActor* Actor);
+
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
+    void OnLevelAdded(ULevel* Level, UWorld* InWorld);
+    void OnLevelRemoved(ULevel* Level, UWorld* InWorld);
+
+    TWeakObjectPtr<UWorld> BoundWorld;
+    TMap<FName, TWeakObjectPtr<AActor>> Actors;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+};
@@ -0,0 +1,163 @@
+#include "WorldObjectTable.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+    // 움직임은 받은 속도로 외삽하고 보간은 남은 오차만 줄이므로 빠르게 수렴해도 튀지 않음
+    constexpr float DefaultInterpSpeed = 8.f;
+}
+
+int32 FPknuWorldObjectTable::Find(FPknuEntityHandle Handle) const
+{
+    if (!Handle.IsValid()) return INDEX_NONE;
+
+    const int32 Slot = static_cast<int32>(Handle.GetIndex());
+    if (!SlotToRow.IsValidIndex(Slot)) return INDEX_NONE;
+
+    // 같은 슬롯을 재사용한 다른 세대의 핸들이면 없는 것으로 봄
+    const int32 Row = SlotToRow[Slot];
+    return Row != INDEX_NONE && Handles[Row] == Handle ? Row : INDEX_NONE;
+}
+
+int32 FPknuWorldObjectTable::FindOrAdd(FPknuEntityHandle Handle)
+{
+    check(Handle.IsValid());
+
+    const int32 Existing = Find(Handle);
+    if (Existing != INDEX_NONE) return Existing;
+
+    const int32 Slot = static_cast<int32>(Handle.GetIndex());
+    if (Slot >= SlotToRow.Num())
+    {
+        const int32 OldNum = SlotToRow.Num();
+        SlotToRow.SetNumUninitialized(Slot + 1);
+        for (int32 i = OldNum; i < SlotToRow.Num(); ++i)
+        {
+            SlotToRow[i] = INDEX_NONE;
+        }
+    }
+
+    const int32 Row = Handles.Add(Handle);
+    Actors.AddDefaulted();
+    LastSentTransforms.Add(FTransform::Identity);
+    TargetTransforms.Add(FTransform::Identity);
+    InterpSpeeds.Add(DefaultInterpSpeed);
+    ReceiveTimes.Add(0.0);
+    LinearVelocities.Add(FVector::ZeroVector);
+    AngularVelocities.Add(FVector::ZeroVector);
+    LastSentLinearVelocities.Add(FVector::ZeroVector);
+    LastSentAngularVelocities.Add(FVector::ZeroVector);
+    LastSentTimes.Add(0.0);
+    OwnerHandles.Add(0);
+    OwnerExpireTimes.Add(0.0);
+    LastPushTimes.Add(-UE_BIG_NUMBER);
+    Flags.Add(EPknuWorldObjectFlags::None);
+
+    SlotToRow[Slot] = Row;
+    return Row;
+}
+
+void FPknuWorldObjectTable::RemoveAtSwap(int32 Index)
+{
+    if (!Handles.IsValidIndex(Index)) return;
+
+    if (HasFlags(Index, EPknuWorldObjectFlags::Awake))
+    {
+        ActiveHandles.RemoveSingleSwap(Handles[Index], EAllowShrinking::No);
+    }
+    if (HasFlags(Index, EPknuWorldObjectFlags::Dirty))
+    {
+        DirtyHandles.RemoveSingleSwap(Handles[Index], EAllowShrinking::No);
+    }
+
+    // 마지막 행이 Index 로 옮겨지므로 그 핸들의 행 인덱스를 갱신
+    const int32 LastIndex = Handles.Num() - 1;
+    SlotToRow[Handles[Index].GetIndex()] = INDEX_NONE;
+    if (Index != LastIndex)
+    {
+        SlotToRow[Handles[LastIndex].GetIndex()] = Index;
+    }
+
+    Handles.RemoveAtSwap(Index, EAllowShrinking::No);
+    Actors.RemoveAtSwap(Index, EAllowShrinking::No);
+    LastSentTransforms.RemoveAtSwap(Index, EAllowShrinking::No);
+    TargetTransforms.RemoveAtSwap(Index, EAllowShrinking::No);
+    InterpSpeeds.RemoveAtSwap(Index, EAllowShrinking::No);
+    ReceiveTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    LinearVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    AngularVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    LastSentLinearVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    LastSentAngularVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    LastSentTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    OwnerHandles.RemoveAtSwap(Index, EAllowShrinking::No);
+    OwnerExpireTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    LastPushTimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    Flags.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+void FPknuWorldObjectTable::Wake(int32 Index)
+{
+    if (HasFlags(Index, EPknuWorldObjectFlags::Awake)) return;
+
+    Flags[Index] |= EPknuWorldObjectFlags::Awake;
+    ActiveHandles.Add(Handles[Index]);
+}
+
+void FPknuWorldObjectTable::Sleep(int32 ActiveIndex)
+{
+    const int32 Row = Find(ActiveHandles[ActiveIndex]);
+    if (Row != INDEX_NONE)
+    {
+        EnumRemoveFlags(Flags[Row], EPknuWorldObjectFlags::Awake);
+    }
+    ActiveHandles.RemoveAtSwap(ActiveIndex, EAllowShrinking::No);
+}
+
+void FPknuWorldObjectTable::MarkDirty(int32 Index)
+{
+    Flags[Index] |= EPknuWorldObjectFlags::Moved;
+    if (HasFlags(Index, EPknuWorldObjectFlags::Dirty)) return;
+
+    Flags[Index] |= EPknuWorldObjectFlags::Dirty;
+    DirtyHandles.Add(Handles[Index]);
+}
+
+void FPknuWorldObjectTable::ClearDirty(int32 DirtyIndex)
+{
+    const int32 Row = Find(DirtyHandles[DirtyIndex]);
+    if (Row != INDEX_NONE)
+    {
+        EnumRemoveFlags(Flags[Row], EPknuWorldObjectFlags::Dirty | EPknuWorldObjectFlags::Moved);
+    }
+    DirtyHandles.RemoveAtSwap(DirtyIndex, EAllowShrinking::No);
+}
+
+bool FPknuWorldObjectTable::ConsumeMoved(int32 Index)
+{
+    if (!HasFlags(Index, EPknuWorldObjectFlags::Moved)) return false;
+
+    EnumRemoveFlags(Flags[Index], EPknuWorldObjectFlags::Moved);
+    return true;
+}
+
+void FPknuWorldObjectTable::Reset()
+{
+    Handles.Reset();
+    Actors.Reset();
+    LastSentTransforms.Reset();
+    TargetTransforms.Reset();
+    InterpSpeeds.Reset();
+    ReceiveTimes.Reset();
+    LinearVelocities.Reset();
+    AngularVelocities.Reset();
+    LastSentLinearVelocities.Reset();
+    LastSentAngularVelocities.Reset();
+    LastSentTimes.Reset();
+    OwnerHandles.Reset();
+    OwnerExpireTimes.Reset();
+    LastPushTimes.Reset();
+    Flags.Reset();
+    ActiveHandles.Reset();
+    DirtyHandles.Reset();
+    SlotToRow.Reset();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EntityHandleTable.h"
+
+class AActor;
+
+// FPknuWorldObjectTable 행 플래그
+enum class EPknuWorldObjectFlags : uint8
+{
+    None = 0,
+    Tracked = 1 << 0,     // 이 클라이언트가 서버에 알린 오브젝트. 로컬에서 움직이면 전송
+    HasLastSent = 1 << 1, // LastSentTransforms 유효
+    HasTarget = 1 << 2,   // TargetTransforms 유효 (서버에서 받은 목표로 보간)
+    Awake = 1 << 3,       // ActiveHandles 에 있음 (목표를 향해 이동 중)
+    Dirty = 1 << 4,       // DirtyHandles 에 있음 (마지막 전송 이후 로컬에서 움직였을 수 있음)
+    Moved = 1 << 5,       // 지난 전송 확인 이후 움직임 알림을 받음 (없으면 멈춘 것으로 봄)
+};
+ENUM_CLASS_FLAGS(EPknuWorldObjectFlags);
+
+/**
+ * 월드 오브젝트 복제 상태 테이블.
+ *
+ * 오브젝트 하나가 한 행이고 모든 열은 같은 인덱스를 쓰는 연속 배열이다 (URemoteAvatarSubsystem 과 같은 SoA).
+ * 행은 조밀하게 유지되며 제거 시 마지막 행을 빈자리로 옮긴다. 밖에서는 행 인덱스 대신 FPknuEntityHandle 로 찾고,
+ * 핸들의 슬롯 인덱스 -> 행 인덱스 배열로 해시 없이 찾은 뒤 세대까지 비교한다.
+ * 행 인덱스는 Add / RemoveAtSwap 사이에서만 유효하다.
+ *
+ * 새 목표를 받은 행은 Wake 로 ActiveHandles 에 들어가고, 목표에 도달하면 Sleep 으로 빠진다.
+ * 보간 패스는 ActiveHandles 만 훑으므로 비용이 동기화된 오브젝트 수가 아니라 움직이는 오브젝트 수에 비례한다.
+ * 마찬가지로 Tracked 행은 루트 컴포넌트가 움직였다는 알림을 받으면 MarkDirty 로 DirtyHandles 에 들어가고,
+ * 전송 패스는 DirtyHandles 만 확인한다. 보냈거나 보낼 필요가 없는 행은 ClearDirty 로 빼고, 임계값 미만으로 움직인 행은
+ * 멈출 때까지(다음 확인 때 Moved 가 없을 때까지) 남겨 두었다가 마지막 상태를 보낸다.
+ *
+ * 물리 오브젝트는 한 번에 한 클라이언트(OwnerHandles)만 시뮬레이션 결과를 보낸다. 소유자는 마지막으로 민 클라이언트이고
+ * 서버가 정한다 (server_code.js claimObject). 받은 속도(LinearVelocities / AngularVelocities)로 목표를 외삽하므로
+ * 송신 쪽은 같은 외삽에서 벗어날 때만 보내면 된다 (LastSent* 열).
+ */
+class PROJECT_PKNU_API FPknuWorldObjectTable
+{
+public:
+    // 없으면 INDEX_NONE
+    int32 Find(FPknuEntityHandle Handle) const;
+    // 없으면 기본값 행을 추가
+    int32 FindOrAdd(FPknuEntityHandle Handle);
+    void RemoveAtSwap(int32 Index);
+
+    // 행을 활성 목록에 추가 (이미 깨어 있으면 아무것도 하지 않음)
+    void Wake(int32 Index);
+    // ActiveHandles[ActiveIndex] 를 목록에서 빼고 Awake 해제 (마지막 항목이 그 자리로 옴)
+    void Sleep(int32 ActiveIndex);
+
+    // 행을 전송 확인 목록에 추가하고 Moved 표시 (이미 목록에 있으면 Moved 만)
+    void MarkDirty(int32 Index);
+    // DirtyHandles[DirtyIndex] 를 목록에서 빼고 Dirty / Moved 해제 (마지막 항목이 그 자리로 옴)
+    void ClearDirty(int32 DirtyIndex);
+    // Moved 였으면 해제하고 true
+    bool ConsumeMoved(int32 Index);
+
+    void Reset();
+
+    int32 Num() const { return Handles.Num(); }
+    bool HasFlags(int32 Index, EPknuWorldObjectFlags InFlags) const { return EnumHasAllFlags(Flags[Index], InFlags); }
+
+    // 열 (모두 같은 인덱스)
+    TArray<FPknuEntityHandle> Handles;
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    TArray<FTransform> LastSentTransforms; // 마지막으로 서버에 보낸 Transform
+    TArray<FTransform> TargetTransforms;   // 서버에서 받은 목표 Transform
+    TArray<float> InterpSpeeds;
+    TArray<double> ReceiveTimes;           // 마지막 목표 수신 시각 (FPknuClockSync::LocalNow)
+    TArray<FVector> LinearVelocities;      // 받은 목표의 속도 (cm/s)
+    TArray<FVector> AngularVelocities;     // 받은 목표의 각속도 (deg/s, 월드 축)
+    TArray<FVector> LastSentLinearVelocities;
+    TArray<FVector> LastSentAngularVelocities;
+    TArray<double> LastSentTimes;          // 마지막 전송 시각 (LocalNow)
+    TArray<uint32> OwnerHandles;           // 시뮬레이션 소유자의 서버 핸들 (0 = 없음)
+    TArray<double> OwnerExpireTimes;       // 이 시각(LocalNow)까지 소유자에게서 소식이 없으면 소유권이 풀린 것으로 봄
+    TArray<double> LastPushTimes;          // 내 캐릭터가 마지막으로 부딪힌 시각 (LocalNow)
+    TArray<EPknuWorldObjectFlags> Flags;
+
+    // 깨어 있는 행의 핸들 (순서 없음)
+    TArray<FPknuEntityHandle> ActiveHandles;
+    // 움직임 알림을 받은 Tracked 행의 핸들 (순서 없음)
+    TArray<FPknuEntityHandle> DirtyHandles;
+
+private:
+    // 핸들의 슬롯 인덱스 -> 행 인덱스 (INDEX_NONE = 없음)
+    TArray<int32> SlotToRow;
+};
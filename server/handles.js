@@ -0,0 +1,63 @@
+// 세대(generation)가 붙은 uint32 엔티티 핸들 (클라이언트 EntityHandleTable.h 와 같은 레이아웃)
+//   하위 20bit : 슬롯 인덱스, 상위 12bit : 세대 (1부터 시작, 0 은 무효 핸들)
+// 슬롯을 재사용할 때마다 세대가 바뀌므로, 나간 플레이어의 오래된 핸들은 새 엔티티와 매칭되지 않는다.
+
+const INDEX_BITS = 20;
+const INDEX_MASK = (1 << INDEX_BITS) - 1;
+const GENERATION_MASK = (1 << (32 - INDEX_BITS)) - 1;
+
+function makeHandle(index, generation) {
+  return ((generation << INDEX_BITS) | index) >>> 0;
+}
+
+function createHandleTable() {
+  const slots = [];        // index -> { name, generation, handle }
+  const freeIndices = [];
+  const byName = new Map(); // name -> handle
+
+  return {
+    // 이미 있으면 기존 핸들, 없으면 새로 할당. isNew 로 handle_map 전송 여부 판단
+    allocate(name) {
+      const existing = byName.get(name);
+      if (existing !== undefined) return { handle: existing, isNew: false };
+
+      const index = freeIndices.length > 0 ? freeIndices.pop() : slots.length;
+      if (index > INDEX_MASK) throw new Error('entity handle table full');
+      const prev = slots[index];
+      let generation = prev ? (prev.generation + 1) & GENERATION_MASK : 1;
+      if (generation === 0) generation = 1;
+
+      const handle = makeHandle(index, generation);
+      slots[index] = { name, generation, handle };
+      byName.set(name, handle);
+      return { handle, isNew: true };
+    },
+
+    release(name) {
+      const handle = byName.get(name);
+      if (handle === undefined) return undefined;
+      byName.delete(name);
+      const slot = slots[handle & INDEX_MASK];
+      slot.name = null;
+      slot.handle = 0;
+      freeIndices.push(handle & INDEX_MASK);
+      return handle;
+    },
+
+    handleOf(name) {
+      return byName.get(name);
+    },
+
+    // 패킷 경로: 배열 인덱스 + 세대 비교만
+    nameOf(handle) {
+      const slot = slots[handle & INDEX_MASK];
+      return slot && slot.handle === handle ? slot.name : undefined;
+    },
+
+    entries() {
+      return Array.from(byName.entries()).map(([id, h]) => ({ h, id }));
+    }
+  };
+}
+
+module.exports = { INDEX_BITS, createHandleTable };
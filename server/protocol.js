@@ -0,0 +1,497 @@
+// 바이너리 와이어 포맷 (클라이언트 BinaryProtocol.h / TransformQuantization.h 와 동일한 레이아웃)
+// 엔티티는 서버가 할당한 uint32 핸들로 식별 (handles.js, 이름과의 대응은 handle_map 메시지로 전달).
+// 모든 값은 little-endian.
+//
+// quantized transform (LSB-first 비트 패킹, 바이트 경계 패딩)
+//   x, y, z     : positionBits 씩 (레벨 경계 기준 고정소수점)
+//   rotation    : 2bit (생략된 성분 index) + 3 x rotationBits (smallest-three 쿼터니언)
+//
+// TRANSFORM / WORLD_TRANSFORM (클라이언트 -> 서버, ack 된 baseline 대비 델타)
+//   uint8 kind, uint32 handle, uint16 seq, uint16 baseline (0xFFFF = 키프레임), uint8 fieldMask
+//   fieldMask 에 켜진 필드만 비트 패킹 (x/y/z, rotation, speed: 16bit, isFalling: 1bit), 바이트 경계 패딩
+//   [TRANSFORM] double ts
+//   [WORLD_TRANSFORM] 3 x int16 velocity (cm/s), 3 x int16 angularVelocity (deg/s), uint8 flags (bit0 = claim)
+//   claim : 송신자가 직접 밀어서 다른 클라이언트의 시뮬레이션 소유권을 넘겨받으려 함
+//
+// ACK (서버 -> 클라이언트)
+//   uint8 kind, uint8 count, count x (uint32 handle, uint16 seq)
+//
+// BATCH (클라이언트 -> 서버, 한 네트워크 틱에 만든 프레임 묶음)
+//   uint8 kind, uint8 count, count x (uint16 length, length 바이트의 TRANSFORM / WORLD_TRANSFORM 프레임)
+//
+// UPDATE_BATCH (서버 -> 클라이언트, 서버 틱마다 한 번 : render_update / update_batch)
+//   uint8 kind, double serverTime (서버 시계 ms), uint16 playerCount,
+//   playerCount x (uint32 handle, quantized transform, uint16 speed, uint8 flags, uint16 ageMs)
+//   ageMs = serverTime - 플레이어가 보낸 ts (받는 쪽은 serverTime - ageMs 를 송신 시각으로 사용)
+//   uint16 objectCount, objectCount x (uint32 handle, uint32 src, quantized transform,
+//                                      3 x int16 velocity (cm/s), 3 x int16 angularVelocity (deg/s))
+//   src = 오브젝트의 시뮬레이션 소유자 (그 클라이언트만 transform 을 보냄)
+//
+// STATE_CHUNK (서버 -> 클라이언트, hello 에 stateChunks 를 보낸 클라이언트의 초기 상태 동기화)
+//   uint8 kind, uint16 syncId, uint16 chunk, uint16 chunkCount, uint32 rawSize
+//   zlib 으로 압축한 UTF-8 JSON (state_sync 와 같은 형태, 엔티티 일부만 포함)
+//   클라이언트는 청크를 적용한 뒤 { type: 'state_chunk_ack', syncId, chunk } 로 응답
+
+const zlib = require('zlib');
+
+const BINARY_VERSION = 8;
+
+const MSG = {
+  TRANSFORM: 1,        // 클라이언트 -> 서버 : 플레이어 transform (델타)
+  // 2, 3 : 엔티티별 전체 상태 프레임 (update_batch 로 대체, 재사용하지 않음)
+  WORLD_TRANSFORM: 4,  // 클라이언트 -> 서버 : 월드 오브젝트 transform (델타)
+  ACK: 5,              // 서버 -> 클라이언트 : 델타 프레임 수신 확인
+  BATCH: 6,            // 클라이언트 -> 서버 : 프레임 묶음
+  UPDATE_BATCH: 7,     // 서버 -> 클라이언트 : 서버 틱 스냅샷
+  STATE_CHUNK: 8       // 서버 -> 클라이언트 : 압축된 초기 상태 청크
+};
+
+const FIELD = { X: 1, Y: 2, Z: 4, ROTATION: 8, SPEED: 16, FALLING: 32, ALL: 63 };
+const KEYFRAME_BASELINE = 0xFFFF;
+const VELOCITY_BYTES = 12; // 3 x int16 velocity + 3 x int16 angularVelocity
+const WORLD_FLAG_CLAIM = 1;
+const DELTA_HISTORY_SIZE = 32;
+
+const DEG_TO_RAD = Math.PI / 180;
+const RAD_TO_DEG = 180 / Math.PI;
+const INV_SQRT_2 = Math.SQRT1_2;
+
+// ---------------------------------------------------------------------------
+// LSB-first 비트 스트림
+// ---------------------------------------------------------------------------
+
+class BitWriter {
+  constructor() { this.bytes = []; this.acc = 0; this.bits = 0; }
+
+  write(value, numBits) {
+    // 32비트를 넘는 시프트를 피하기 위해 한 비트씩 누적
+    for (let i = 0; i < numBits; i++) {
+      if (Math.floor(value / 2 ** i) % 2) this.acc |= 1 << this.bits;
+      if (++this.bits === 8) { this.bytes.push(this.acc); this.acc = 0; this.bits = 0; }
+    }
+  }
+
+  flush() {
+    if (this.bits > 0) { this.bytes.push(this.acc); this.acc = 0; this.bits = 0; }
+    return Buffer.from(this.bytes);
+  }
+}
+
+class BitReader {
+  constructor(buf, offset) { this.buf = buf; this.byte = offset; this.bit = 0; }
+
+  read(numBits) {
+    let value = 0;
+    for (let i = 0; i < numBits; i++) {
+      if (this.byte >= this.buf.length) return null;
+      if ((this.buf[this.byte] >> this.bit) & 1) value += 2 ** i;
+      if (++this.bit === 8) { this.bit = 0; this.byte++; }
+    }
+    return value;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 회전 변환 (FRotator::Quaternion / FQuat::Rotator 와 같은 공식)
+// ---------------------------------------------------------------------------
+
+function rotatorToQuat(r) {
+  const hp = (Number(r.pitch) || 0) * DEG_TO_RAD / 2;
+  const hy = (Number(r.yaw) || 0) * DEG_TO_RAD / 2;
+  const hr = (Number(r.roll) || 0) * DEG_TO_RAD / 2;
+  const SP = Math.sin(hp), CP = Math.cos(hp);
+  const SY = Math.sin(hy), CY = Math.cos(hy);
+  const SR = Math.sin(hr), CR = Math.cos(hr);
+  return [
+    CR * SP * SY - SR * CP * CY,
+    -CR * SP * CY - SR * CP * SY,
+    CR * CP * SY - SR * SP * CY,
+    CR * CP * CY + SR * SP * SY
+  ];
+}
+
+function normalizeAxis(angle) {
+  angle %= 360;
+  if (angle > 180) angle -= 360;
+  else if (angle <= -180) angle += 360;
+  return angle;
+}
+
+function quatToRotator([X, Y, Z, W]) {
+  const singularityTest = Z * X - W * Y;
+  const yawY = 2 * (W * Z + X * Y);
+  const yawX = 1 - 2 * (Y * Y + Z * Z);
+  const THRESHOLD = 0.4999995;
+
+  const yaw = Math.atan2(yawY, yawX) * RAD_TO_DEG;
+  if (singularityTest < -THRESHOLD) {
+    return { pitch: -90, yaw, roll: normalizeAxis(-yaw - 2 * Math.atan2(X, W) * RAD_TO_DEG) };
+  }
+  if (singularityTest > THRESHOLD) {
+    return { pitch: 90, yaw, roll: normalizeAxis(yaw - 2 * Math.atan2(X, W) * RAD_TO_DEG) };
+  }
+  return {
+    pitch: Math.asin(2 * singularityTest) * RAD_TO_DEG,
+    yaw,
+    roll: Math.atan2(-2 * (W * X + Y * Z), 1 - 2 * (X * X + Y * Y)) * RAD_TO_DEG
+  };
+}
+
+// ---------------------------------------------------------------------------
+// 양자화 (FTransformQuantizer 와 동일)
+// ---------------------------------------------------------------------------
+
+class Quantizer {
+  constructor({ min, max, positionBits, rotationBits }) {
+    this.min = min.map(Number);
+    this.max = max.map(Number);
+    this.positionBits = Math.min(30, Math.max(8, positionBits | 0));
+    this.rotationBits = Math.min(10, Math.max(6, rotationBits | 0));
+  }
+
+  toJSON() {
+    return { min: this.min, max: this.max, positionBits: this.positionBits, rotationBits: this.rotationBits };
+  }
+
+  packedBytes() {
+    return Math.ceil((3 * this.positionBits + 2 + 3 * this.rotationBits) / 8);
+  }
+
+  quantize(position, rotation) {
+    const maxValue = 2 ** this.positionBits - 1;
+    const p = position || {};
+    const axes = [p.x, p.y, p.z].map((v, i) => {
+      const range = this.max[i] - this.min[i];
+      if (range <= 0) return 0;
+      const alpha = Math.min(1, Math.max(0, ((Number(v) || 0) - this.min[i]) / range));
+      return Math.round(alpha * maxValue);
+    });
+
+    const q = rotatorToQuat(rotation || {});
+    const len = Math.hypot(q[0], q[1], q[2], q[3]) || 1;
+    for (let i = 0; i < 4; i++) q[i] /= len;
+
+    let largest = 0;
+    for (let i = 1; i < 4; i++) if (Math.abs(q[i]) > Math.abs(q[largest])) largest = i;
+    const sign = q[largest] < 0 ? -1 : 1;
+
+    const rotMax = 2 ** this.rotationBits - 1;
+    const rest = [];
+    for (let i = 0; i < 4; i++) {
+      if (i === largest) continue;
+      const alpha = Math.min(1, Math.max(0, (q[i] * sign + INV_SQRT_2) / (2 * INV_SQRT_2)));
+      rest.push(Math.round(alpha * rotMax));
+    }
+
+    return { x: axes[0], y: axes[1], z: axes[2], largest, rest };
+  }
+
+  dequantize(qt) {
+    const maxValue = 2 ** this.positionBits - 1;
+    const axis = (v, i) => this.min[i] + (this.max[i] - this.min[i]) * (v / maxValue);
+
+    const rotMax = 2 ** this.rotationBits - 1;
+    const q = [0, 0, 0, 0];
+    let sumSquares = 0;
+    let r = 0;
+    for (let i = 0; i < 4; i++) {
+      if (i === qt.largest) continue;
+      q[i] = (qt.rest[r++] / rotMax) * (2 * INV_SQRT_2) - INV_SQRT_2;
+      sumSquares += q[i] * q[i];
+    }
+    q[qt.largest] = Math.sqrt(Math.max(0, 1 - sumSquares));
+
+    return {
+      position: { x: axis(qt.x, 0), y: axis(qt.y, 1), z: axis(qt.z, 2) },
+      rotation: quatToRotator(q)
+    };
+  }
+
+  write(writer, qt) {
+    writer.write(qt.x, this.positionBits);
+    writer.write(qt.y, this.positionBits);
+    writer.write(qt.z, this.positionBits);
+    writer.write(qt.largest, 2);
+    for (const v of qt.rest) writer.write(v, this.rotationBits);
+  }
+
+  read(reader) {
+    const x = reader.read(this.positionBits);
+    const y = reader.read(this.positionBits);
+    const z = reader.read(this.positionBits);
+    const largest = reader.read(2);
+    const rest = [reader.read(this.rotationBits), reader.read(this.rotationBits), reader.read(this.rotationBits)];
+    if ([x, y, z, largest, ...rest].some(v => v === null)) return null;
+    return { x, y, z, largest, rest };
+  }
+}
+
+const DEFAULT_QUANT = { min: [-500000, -500000, -500000], max: [500000, 500000, 500000], positionBits: 20, rotationBits: 10 };
+
+// 첫 번째로 hello 를 보낸 클라이언트의 레벨 경계를 채택하고, 이후 모든 바이너리 클라이언트가 같은 값을 사용
+let quantizer = null;
+
+function negotiateQuantizer(proposal) {
+  if (!quantizer) {
+    const valid = proposal && Array.isArray(proposal.min) && proposal.min.length === 3 &&
+      Array.isArray(proposal.max) && proposal.max.length === 3;
+    quantizer = new Quantizer(valid ? proposal : DEFAULT_QUANT);
+  }
+  return quantizer;
+}
+
+function currentQuantizer() {
+  return quantizer || negotiateQuantizer(null);
+}
+
+// ---------------------------------------------------------------------------
+// 프레임 인코딩 / 디코딩
+// ---------------------------------------------------------------------------
+
+// { x, y, z } 를 int16 3개로 (범위 밖은 잘라냄). 없는 값은 0
+function writeVector16(buf, offset, v) {
+  const components = v ? [v.x, v.y, v.z] : [0, 0, 0];
+  components.forEach((c, i) => {
+    buf.writeInt16LE(Math.min(32767, Math.max(-32768, Math.round(Number(c) || 0))), offset + i * 2);
+  });
+}
+
+function readVector16(buf, offset) {
+  return { x: buf.readInt16LE(offset), y: buf.readInt16LE(offset + 2), z: buf.readInt16LE(offset + 4) };
+}
+
+function velocityBuffer(state) {
+  const buf = Buffer.allocUnsafe(VELOCITY_BYTES);
+  writeVector16(buf, 0, state && state.velocity);
+  writeVector16(buf, 6, state && state.angularVelocity);
+  return buf;
+}
+
+function handleBuffer(handle) {
+  const buf = Buffer.allocUnsafe(4);
+  buf.writeUInt32LE(handle >>> 0, 0);
+  return buf;
+}
+
+// 델타 프레임 (클라이언트 -> 서버). 서버에서는 테스트/도구용으로만 사용
+// WORLD_TRANSFORM 은 world = { velocity, angularVelocity, claim } 을 꼬리로 붙임
+function encodeDelta(kind, handle, state, seq, baseline, mask, ts, world) {
+  const q = currentQuantizer();
+  const header = Buffer.allocUnsafe(5);
+  header.writeUInt16LE(seq, 0);
+  header.writeUInt16LE(baseline, 2);
+  header.writeUInt8(mask, 4);
+
+  const writer = new BitWriter();
+  if (mask & FIELD.X) writer.write(state.x, q.positionBits);
+  if (mask & FIELD.Y) writer.write(state.y, q.positionBits);
+  if (mask & FIELD.Z) writer.write(state.z, q.positionBits);
+  if (mask & FIELD.ROTATION) {
+    writer.write(state.largest, 2);
+    for (const v of state.rest) writer.write(v, q.rotationBits);
+  }
+  if (mask & FIELD.SPEED) writer.write(state.speed, 16);
+  if (mask & FIELD.FALLING) writer.write(state.isFalling ? 1 : 0, 1);
+
+  const parts = [Buffer.from([kind]), handleBuffer(handle), header, writer.flush()];
+  if (kind === MSG.TRANSFORM) {
+    const tsBuf = Buffer.allocUnsafe(8);
+    tsBuf.writeDoubleLE(Number(ts) || 0, 0);
+    parts.push(tsBuf);
+  } else if (kind === MSG.WORLD_TRANSFORM) {
+    parts.push(velocityBuffer(world), Buffer.from([world && world.claim ? WORLD_FLAG_CLAIM : 0]));
+  }
+  return Buffer.concat(parts);
+}
+
+function encodeAck(entries) {
+  const parts = [Buffer.from([MSG.ACK, Math.min(255, entries.length)])];
+  for (const { h, seq } of entries.slice(0, 255)) {
+    const seqBuf = Buffer.allocUnsafe(2);
+    seqBuf.writeUInt16LE(seq, 0);
+    parts.push(handleBuffer(h), seqBuf);
+  }
+  return Buffer.concat(parts);
+}
+
+// 송신자별 델타 baseline 기록: handle -> Map(seq -> 양자화 상태)
+function createBaselineStore() {
+  return new Map();
+}
+
+function rememberBaseline(store, h, seq, state) {
+  let history = store.get(h);
+  if (!history) { history = new Map(); store.set(h, history); }
+  history.set(seq, state);
+  if (history.size > DELTA_HISTORY_SIZE) {
+    history.delete(history.keys().next().value); // 가장 오래된 seq 제거 (삽입 순서)
+  }
+}
+
+function decodeDelta(buf, o, kind, h, id, baselines) {
+  const q = currentQuantizer();
+  if (o + 5 > buf.length) return null;
+  const seq = buf.readUInt16LE(o);
+  const baselineSeq = buf.readUInt16LE(o + 2);
+  const mask = buf.readUInt8(o + 4);
+  o += 5;
+
+  let base;
+  if (baselineSeq === KEYFRAME_BASELINE) {
+    base = { x: 0, y: 0, z: 0, largest: 3, rest: [0, 0, 0], speed: 0, isFalling: false };
+  } else {
+    const history = baselines && baselines.get(h);
+    base = history && history.get(baselineSeq);
+    // baseline 을 모르면 복원 불가 → ack 하지 않으면 클라이언트가 곧 키프레임을 보냄
+    if (!base) return { dropped: true, id, h, seq };
+  }
+
+  const reader = new BitReader(buf, o);
+  const state = { ...base, rest: base.rest.slice() };
+  if (mask & FIELD.X) state.x = reader.read(q.positionBits);
+  if (mask & FIELD.Y) state.y = reader.read(q.positionBits);
+  if (mask & FIELD.Z) state.z = reader.read(q.positionBits);
+  if (mask & FIELD.ROTATION) {
+    state.largest = reader.read(2);
+    state.rest = [reader.read(q.rotationBits), reader.read(q.rotationBits), reader.read(q.rotationBits)];
+  }
+  if (mask & FIELD.SPEED) state.speed = reader.read(16);
+  if (mask & FIELD.FALLING) state.isFalling = reader.read(1) === 1;
+  if ([state.x, state.y, state.z, state.largest, state.speed, ...state.rest].some(v => v === null)) return null;
+  o = reader.byte + (reader.bit > 0 ? 1 : 0);
+
+  let ts = 0;
+  let velocity, angularVelocity, claim = false;
+  if (kind === MSG.TRANSFORM) {
+    if (o + 8 > buf.length) return null;
+    ts = buf.readDoubleLE(o);
+  } else {
+    if (o + VELOCITY_BYTES + 1 > buf.length) return null;
+    velocity = readVector16(buf, o);
+    angularVelocity = readVector16(buf, o + 6);
+    claim = (buf.readUInt8(o + VELOCITY_BYTES) & WORLD_FLAG_CLAIM) !== 0;
+  }
+
+  if (baselines) rememberBaseline(baselines, h, seq, state);
+
+  const { position, rotation } = q.dequantize(state);
+  const ack = { h, seq };
+  if (kind === MSG.TRANSFORM) {
+    return { type: 'transform', id, ...position, ...rotation, speed: state.speed, isFalling: state.isFalling, ts, ack };
+  }
+  return { type: 'update', entityType: 'world', id, state: { position, rotation, velocity, angularVelocity }, isObject: true, claim, ack };
+}
+
+// 바이너리 프레임을 기존 JSON 메시지와 같은 모양의 객체로 변환 (handleMessage 재사용)
+// 델타 프레임이면 ack 필드({ h, seq })가 붙음. baseline 을 몰라 버린 프레임은 { dropped: true }
+// handles 는 handles.js 의 테이블 (핸들 -> 이름). 모르는 핸들이면 null
+// BATCH 는 { type: 'batch', messages: [...] } (JSON batch 와 같은 모양, 실패/버린 프레임은 제외)
+function decode(buf, baselines, handles) {
+  if (!Buffer.isBuffer(buf) || buf.length < 2) return null;
+
+  let o = 0;
+  const kind = buf.readUInt8(o); o += 1;
+  if (kind === MSG.BATCH) return decodeBatch(buf, baselines, handles);
+
+  if (buf.length < 5) return null;
+  const h = buf.readUInt32LE(o); o += 4;
+  const id = handles ? handles.nameOf(h) : undefined;
+  if (id === undefined) return null;
+
+  switch (kind) {
+    case MSG.TRANSFORM:
+    case MSG.WORLD_TRANSFORM:
+      return decodeDelta(buf, o, kind, h, id, baselines);
+    default:
+      return null;
+  }
+}
+
+function decodeBatch(buf, baselines, handles) {
+  const count = buf.readUInt8(1);
+  const messages = [];
+  let o = 2;
+  for (let i = 0; i < count; i++) {
+    if (o + 2 > buf.length) return null;
+    const length = buf.readUInt16LE(o); o += 2;
+    if (o + length > buf.length) return null;
+    const msg = decode(buf.subarray(o, o + length), baselines, handles);
+    o += length;
+    if (msg && !msg.dropped && msg.type !== 'batch') messages.push(msg);
+  }
+  return { type: 'batch', messages };
+}
+
+function encodeBatch(frames) {
+  const parts = [Buffer.from([MSG.BATCH, Math.min(255, frames.length)])];
+  for (const frame of frames.slice(0, 255)) {
+    const lengthBuf = Buffer.allocUnsafe(2);
+    lengthBuf.writeUInt16LE(frame.length, 0);
+    parts.push(lengthBuf, frame);
+  }
+  return Buffer.concat(parts);
+}
+
+function uint16Buffer(value) {
+  const buf = Buffer.allocUnsafe(2);
+  buf.writeUInt16LE(value, 0);
+  return buf;
+}
+
+// players: [{ h, state }], objects: [{ h, src, state }]. 항목마다 transform 을 바이트 경계로 맞춤
+// 오브젝트 state.velocity / state.angularVelocity 가 없으면 0
+// serverTime 이 없으면 지금 시각. state.ts 가 없는 플레이어는 ageMs 0
+function encodeUpdateBatch(players, objects, serverTime) {
+  const q = currentQuantizer();
+  const now = Number.isFinite(serverTime) ? serverTime : Date.now();
+  const timeBuf = Buffer.allocUnsafe(8);
+  timeBuf.writeDoubleLE(now, 0);
+  const parts = [Buffer.from([MSG.UPDATE_BATCH]), timeBuf, uint16Buffer(Math.min(65535, players.length))];
+
+  for (const p of players.slice(0, 65535)) {
+    const writer = new BitWriter();
+    q.write(writer, q.quantize(p.state.position, p.state.rotation));
+    const tail = Buffer.allocUnsafe(5);
+    tail.writeUInt16LE(Math.min(65535, Math.max(0, Math.round(Number(p.state.speed) || 0))), 0);
+    tail.writeUInt8(p.state.isFalling ? 1 : 0, 2);
+    const ts = Number(p.state.ts);
+    tail.writeUInt16LE(Number.isFinite(ts) ? Math.min(65535, Math.max(0, Math.round(now - ts))) : 0, 3);
+    parts.push(handleBuffer(p.h), writer.flush(), tail);
+  }
+
+  parts.push(uint16Buffer(Math.min(65535, objects.length)));
+  for (const o of objects.slice(0, 65535)) {
+    const writer = new BitWriter();
+    q.write(writer, q.quantize(o.state.position, o.state.rotation));
+    parts.push(handleBuffer(o.h), handleBuffer(o.src || 0), writer.flush(), velocityBuffer(o.state));
+  }
+  return Buffer.concat(parts);
+}
+
+function encodeStateChunk(syncId, chunk, chunkCount, obj) {
+  const raw = Buffer.from(JSON.stringify(obj), 'utf8');
+  const header = Buffer.allocUnsafe(11);
+  header.writeUInt8(MSG.STATE_CHUNK, 0);
+  header.writeUInt16LE(syncId, 1);
+  header.writeUInt16LE(chunk, 3);
+  header.writeUInt16LE(chunkCount, 5);
+  header.writeUInt32LE(raw.length, 7);
+  return Buffer.concat([header, zlib.deflateSync(raw)]);
+}
+
+// 브로드캐스트할 JSON 메시지를 바이너리로 인코딩. 바이너리 표현이 있는 것은 update_batch 뿐이고,
+// 그 외 메시지나 핸들(h)이 없는 항목이 섞인 batch 는 null (JSON 으로 보냄)
+function encode(obj) {
+  if (!obj || obj.type !== 'render_update' || obj.action !== 'update_batch') return null;
+
+  const players = obj.players || [];
+  const objects = obj.objects || [];
+  if (players.some(p => p.h === undefined) || objects.some(o => o.h === undefined)) return null;
+  return encodeUpdateBatch(players, objects, obj.serverTime);
+}
+
+module.exports = {
+  BINARY_VERSION, MSG, FIELD, KEYFRAME_BASELINE, BitWriter, BitReader, Quantizer,
+  rotatorToQuat, quatToRotator, negotiateQuantizer, currentQuantizer, createBaselineStore,
+  decode, encode, encodeDelta, encodeAck, encodeBatch, encodeUpdateBatch, encodeStateChunk
+};
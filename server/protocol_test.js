@@ -0,0 +1,243 @@
+// protocol.js 와이어 포맷 검증 (encode -> 골든 바이트 비교 -> decode 왕복)
+// 골든 벡터는 protocol_vectors.json 에 있고, 클라이언트 자동화 테스트(BinaryProtocolTests.cpp)도 같은 파일을 읽는다.
+//
+//   node protocol_test.js            검증
+//   node protocol_test.js --update   현재 인코더 출력으로 벡터 파일의 기대값(hex, expect 등)을 다시 씀
+//                                    (포맷을 의도적으로 바꿨을 때만. BINARY_VERSION 도 함께 올릴 것)
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const protocol = require('./protocol');
+const { INDEX_BITS, createHandleTable } = require('./handles');
+
+const VECTORS_PATH = path.join(__dirname, 'protocol_vectors.json');
+const update = process.argv.includes('--update');
+const vectors = JSON.parse(fs.readFileSync(VECTORS_PATH, 'utf8'));
+
+let checks = 0;
+
+function expectHex(actual, vector, label) {
+  const hex = actual.toString('hex');
+  if (update) { vector.hex = hex; return; }
+  assert.strictEqual(hex, vector.hex, `${label}: 골든 바이트와 다름`);
+  checks++;
+}
+
+function expectValue(actual, vector, key, label) {
+  if (update) { vector[key] = actual; return; }
+  assert.deepStrictEqual(actual, vector[key], `${label}: ${key} 가 기대값과 다름`);
+  checks++;
+}
+
+function close(a, b, tolerance, label) {
+  assert.ok(Math.abs(a - b) <= tolerance, `${label}: ${a} != ${b} (허용 오차 ${tolerance})`);
+  checks++;
+}
+
+// 회전 비교는 쿼터니언 내적으로 (오일러 각은 특이점 근처에서 표현이 여러 개)
+function closeRotation(a, b, toleranceDeg, label) {
+  const qa = protocol.rotatorToQuat(a);
+  const qb = protocol.rotatorToQuat(b);
+  const dot = Math.min(1, Math.abs(qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3]));
+  close(2 * Math.acos(dot) * 180 / Math.PI, 0, toleranceDeg, label);
+}
+
+assert.strictEqual(vectors.version, protocol.BINARY_VERSION, 'protocol_vectors.json 의 version 이 BINARY_VERSION 과 다름');
+const q = protocol.negotiateQuantizer(vectors.quantizer);
+assert.deepStrictEqual(q.toJSON(), vectors.quantizer, '벡터의 양자화 파라미터가 채택되지 않음 (다른 곳에서 먼저 협상됨)');
+
+// ---------------------------------------------------------------------------
+// 양자화 + smallest-three 패킹
+// ---------------------------------------------------------------------------
+
+const positionStep = Math.max(...q.max.map((max, i) => (max - q.min[i]) / (2 ** q.positionBits - 1)));
+for (const v of vectors.quantize) {
+  const qt = q.quantize(v.position, v.rotation);
+  expectValue(qt, v, 'expect', v.name);
+
+  const writer = new protocol.BitWriter();
+  q.write(writer, qt);
+  const packed = writer.flush();
+  assert.strictEqual(packed.length, q.packedBytes(), `${v.name}: 패킹 길이`);
+  expectHex(packed, v, v.name);
+
+  assert.deepStrictEqual(q.read(new protocol.BitReader(packed, 0)), qt, `${v.name}: 언패킹`);
+  const { position, rotation } = q.dequantize(qt);
+  ['x', 'y', 'z'].forEach((axis, i) => {
+    const clamped = Math.min(q.max[i], Math.max(q.min[i], v.position[axis]));
+    close(position[axis], clamped, positionStep, `${v.name}: 위치 ${axis}`);
+  });
+  closeRotation(rotation, v.rotation, 0.5, `${v.name}: 회전`);
+}
+
+// ---------------------------------------------------------------------------
+// 델타 프레임 (클라이언트 -> 서버) + ACK
+// ---------------------------------------------------------------------------
+
+function clamp16(v) {
+  return Math.min(32767, Math.max(-32768, Math.round(Number(v) || 0)));
+}
+
+// 벡터의 핸들은 새 테이블에 이름 순서대로 할당한 값
+const handles = createHandleTable();
+for (const [name, h] of Object.entries(vectors.entities)) {
+  assert.strictEqual(handles.allocate(name).handle, h, `핸들 ${name}`);
+}
+
+// 순서대로 디코딩해서 baseline 기록을 쌓음 (델타는 앞 벡터의 seq 를 baseline 으로 씀)
+const baselines = protocol.createBaselineStore();
+const deltaFrames = {};
+for (const v of vectors.deltas) {
+  const kind = protocol.MSG[v.kind];
+  const frame = protocol.encodeDelta(kind, v.h, v.state, v.seq, v.baseline, v.mask, v.ts, v.world);
+  expectHex(frame, v, v.name);
+  deltaFrames[v.name] = frame;
+
+  const msg = protocol.decode(frame, baselines, handles);
+  assert.ok(msg && !msg.dropped, `${v.name}: 디코딩 실패`);
+  assert.deepStrictEqual(msg.ack, { h: v.h, seq: v.seq }, `${v.name}: ack`);
+  checks++;
+
+  if (kind === protocol.MSG.WORLD_TRANSFORM) {
+    const vel = v.world.velocity;
+    const ang = v.world.angularVelocity;
+    assert.deepStrictEqual(msg.state.velocity, { x: clamp16(vel.x), y: clamp16(vel.y), z: clamp16(vel.z) }, `${v.name}: velocity`);
+    assert.deepStrictEqual(msg.state.angularVelocity, { x: clamp16(ang.x), y: clamp16(ang.y), z: clamp16(ang.z) }, `${v.name}: angularVelocity`);
+    assert.strictEqual(msg.claim, v.world.claim, `${v.name}: claim`);
+    checks += 3;
+  } else {
+    assert.strictEqual(msg.ts, v.ts, `${v.name}: ts`);
+    checks++;
+  }
+
+  // 마스크에 없는 필드는 baseline 값 유지
+  const state = baselines.get(v.h).get(v.seq);
+  expectValue({ x: state.x, y: state.y, z: state.z, largest: state.largest, rest: state.rest, speed: state.speed, isFalling: state.isFalling },
+    v, 'decoded', v.name);
+}
+
+// baseline 을 모르는 델타는 ack 없이 버림
+{
+  const v = vectors.deltas.find(d => d.baseline !== protocol.KEYFRAME_BASELINE);
+  const msg = protocol.decode(deltaFrames[v.name], protocol.createBaselineStore(), handles);
+  assert.ok(msg && msg.dropped, '모르는 baseline 의 델타가 버려지지 않음');
+  checks++;
+}
+
+{
+  const v = vectors.ack;
+  const frame = protocol.encodeAck(v.entries);
+  expectHex(frame, v, 'ack');
+  assert.strictEqual(frame[1], v.entries.length);
+  v.entries.forEach((e, i) => {
+    assert.strictEqual(frame.readUInt32LE(2 + i * 6), e.h);
+    assert.strictEqual(frame.readUInt16LE(6 + i * 6), e.seq);
+  });
+  checks++;
+}
+
+// ---------------------------------------------------------------------------
+// 세대 핸들 (슬롯 재사용 시 세대가 올라가고, 반납된 핸들은 더 이상 매칭되지 않음)
+// ---------------------------------------------------------------------------
+
+{
+  const table = createHandleTable();
+  const live = new Map(); // name -> handle
+  for (const step of vectors.handles) {
+    if (step.op === 'allocate') {
+      const { handle, isNew } = table.allocate(step.name);
+      assert.ok(isNew, `handles: ${step.name} 이 새로 할당되지 않음`);
+      expectValue(handle, step, 'h', `handles: ${step.name}`);
+      expectValue({ index: handle & ((1 << INDEX_BITS) - 1), generation: handle >>> INDEX_BITS }, step, 'slot', `handles: ${step.name}`);
+      live.set(step.name, handle);
+    } else {
+      assert.strictEqual(table.release(step.name), live.get(step.name), `handles: ${step.name} 반납`);
+      assert.strictEqual(table.nameOf(live.get(step.name)), undefined, `handles: 반납된 ${step.name} 핸들이 아직 매칭됨`);
+      live.delete(step.name);
+      checks++;
+    }
+  }
+  for (const [name, h] of live) {
+    assert.strictEqual(table.nameOf(h), name, `handles: ${name}`);
+    assert.strictEqual(table.allocate(name).isNew, false, `handles: ${name} 재할당`);
+    checks++;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// BATCH (델타 프레임 묶음)
+// ---------------------------------------------------------------------------
+
+{
+  const v = vectors.batch;
+  const frame = protocol.encodeBatch(v.frames.map(name => deltaFrames[name]));
+  expectHex(frame, v, 'batch');
+
+  // baseline 기록은 위에서 이미 쌓였으므로 같은 store 로 다시 디코딩 가능
+  const msg = protocol.decode(frame, baselines, handles);
+  assert.strictEqual(msg.type, 'batch');
+  assert.deepStrictEqual(msg.messages.map(m => m.ack), v.frames.map(name => {
+    const d = vectors.deltas.find(delta => delta.name === name);
+    return { h: d.h, seq: d.seq };
+  }));
+  checks += 2;
+}
+
+// ---------------------------------------------------------------------------
+// UPDATE_BATCH (서버는 이 프레임을 디코딩하지 않으므로 레이아웃을 여기서 직접 읽음)
+// ---------------------------------------------------------------------------
+
+{
+  const v = vectors.updateBatch;
+  const frame = protocol.encodeUpdateBatch(v.players, v.objects, v.serverTime);
+  expectHex(frame, v, 'updateBatch');
+
+  let o = 0;
+  assert.strictEqual(frame.readUInt8(o), protocol.MSG.UPDATE_BATCH); o += 1;
+  assert.strictEqual(frame.readDoubleLE(o), v.serverTime); o += 8;
+  assert.strictEqual(frame.readUInt16LE(o), v.players.length); o += 2;
+  for (const p of v.players) {
+    assert.strictEqual(frame.readUInt32LE(o), p.h); o += 4;
+    const qt = q.read(new protocol.BitReader(frame, o)); o += q.packedBytes();
+    assert.deepStrictEqual(qt, q.quantize(p.state.position, p.state.rotation));
+    assert.strictEqual(frame.readUInt16LE(o), Math.round(p.state.speed)); o += 2;
+    assert.strictEqual(frame.readUInt8(o), p.state.isFalling ? 1 : 0); o += 1;
+    assert.strictEqual(frame.readUInt16LE(o), Math.round(v.serverTime - p.state.ts)); o += 2;
+  }
+  assert.strictEqual(frame.readUInt16LE(o), v.objects.length); o += 2;
+  for (const obj of v.objects) {
+    assert.strictEqual(frame.readUInt32LE(o), obj.h); o += 4;
+    assert.strictEqual(frame.readUInt32LE(o), obj.src); o += 4;
+    const qt = q.read(new protocol.BitReader(frame, o)); o += q.packedBytes();
+    assert.deepStrictEqual(qt, q.quantize(obj.state.position, obj.state.rotation));
+    for (const vec of [obj.state.velocity, obj.state.angularVelocity]) {
+      for (const axis of ['x', 'y', 'z']) { assert.strictEqual(frame.readInt16LE(o), clamp16(vec[axis])); o += 2; }
+    }
+  }
+  assert.strictEqual(o, frame.length, 'updateBatch: 남는 바이트');
+  checks++;
+}
+
+// ---------------------------------------------------------------------------
+// STATE_CHUNK (zlib 출력은 zlib 버전마다 다를 수 있으므로 헤더만 골든 비교, 본문은 압축 해제 후 비교)
+// ---------------------------------------------------------------------------
+
+{
+  const v = vectors.stateChunk;
+  const frame = protocol.encodeStateChunk(v.syncId, v.chunk, v.chunkCount, v.state);
+  const json = zlib.inflateSync(frame.subarray(11)).toString('utf8');
+  assert.strictEqual(json, JSON.stringify(v.state));
+  assert.strictEqual(frame.readUInt32LE(7), Buffer.byteLength(json, 'utf8'));
+  checks++;
+  expectValue(frame.subarray(0, 11).toString('hex'), v, 'header', 'stateChunk');
+  if (update) v.hex = frame.toString('hex');
+}
+
+if (update) {
+  fs.writeFileSync(VECTORS_PATH, JSON.stringify(vectors, null, 2) + '\n');
+  console.log(`${path.basename(VECTORS_PATH)} 갱신`);
+} else {
+  console.log(`protocol_test: ${checks} checks OK`);
+}
@@ -1,7 +1,10 @@
 
 
 const WebSocket = require('ws');
+const { performance } = require('perf_hooks');
 const { v4: uuidv4 } = require('uuid');
+const protocol = require('./protocol');
+const { createHandleTable } = require('./handles');
 
 const PORT = 8080;
 const wss = new WebSocket.Server({ port: PORT });
@@ -12,43 +15,104 @@ let initialized = false;
 const worldObjects = new Map();
 const playerCharacters = new Map();
 const clients = new Map();
+// 플레이어 / 월드 오브젝트 이름 -> uint32 핸들. 등록 시 한 번 handle_map 으로 알리고 이후에는 핸들로만 식별
+const handles = createHandleTable();
+
+// 고정 주기 스냅샷: transform / update 는 즉시 중계하지 않고 dirty 로 표시만 한 뒤,
+// 틱마다 변경된 엔티티의 최신 상태를 update_batch 한 프레임으로 모든 클라이언트에 전송
+const TICK_RATE_HZ = Number(process.env.TICK_RATE_HZ) || 20;
+const TICK_INTERVAL_MS = 1000 / TICK_RATE_HZ;
+const METRICS_INTERVAL_MS = 10000;
+const dirtyPlayers = new Set();
+const dirtyObjects = new Map(); // objectID -> 마지막으로 바꾼 플레이어 핸들 (src, 그 클라이언트는 자기 변경을 다시 적용하지 않음)
+
+// 월드 오브젝트 시뮬레이션 소유권: 오브젝트마다 한 클라이언트만 transform 을 보낼 수 있음.
+// 소유자가 OWNERSHIP_TIMEOUT_MS 동안 보내지 않으면 풀리고, 다른 클라이언트가 직접 밀었을 때(claim)는
+// 현재 소유자가 OWNERSHIP_MIN_HOLD_MS 이상 가졌던 경우에만 넘겨줌 (동시에 밀 때 소유권이 매 틱 오가지 않도록)
+const OWNERSHIP_TIMEOUT_MS = 1000;
+const OWNERSHIP_MIN_HOLD_MS = 200;
+const objectOwners = new Map(); // objectID -> { ws, since, until }
+
+// 초기 상태 동기화: hello 에 stateChunks 가 있으면 zlib 압축 청크로 나눠 보내고,
+// 클라이언트가 state_chunk_ack 로 적용을 알릴 때마다 다음 청크를 보냄 (최대 STATE_CHUNK_WINDOW 개 미확인)
+const STATE_CHUNK_ENTITIES = 256;
+const STATE_CHUNK_WINDOW = 2;
+const HELLO_TIMEOUT_MS = 200; // 아무것도 보내지 않는 구버전 클라이언트는 이 시간 뒤 한 번에 state_sync
+let nextSyncId = 0;
+
+// 시계 동기화: 서버 시계(UTC ms)를 기준으로 클라이언트가 ping / pong 으로 offset 을 추정하고
+// transform 의 ts 를 서버 시계로 찍어 보냄. ts 는 update_batch 로 그대로 전달됨
+const MAX_TS_SKEW_MS = 1000; // 이보다 어긋난 ts(동기화 전 클라이언트의 틀린 시계)는 수신 시각으로 대체
+
+function serverNowMs() {
+  return performance.timeOrigin + performance.now();
+}
+
+// 받은 ts 를 검증해 플레이어 상태에 남길 송신 시각으로 변환 (미래 시각은 지금으로 제한)
+function senderTimestamp(ts) {
+  const now = serverNowMs();
+  const value = Number(ts);
+  if (!Number.isFinite(value) || Math.abs(value - now) > MAX_TS_SKEW_MS) return now;
+  return Math.min(value, now);
+}
 
 
 wss.on('connection', (ws) => {
   const connectionId = uuidv4();
-  clients.set(ws, { connectionId, playerID: null });
+  clients.set(ws, { connectionId, playerID: null, binary: false, baselines: protocol.createBaselineStore() });
   console.log(`클라이언트 접속: connectionId=${connectionId}`);
 
-  // 초기 전체 상태 전송
-  send(ws, {
-    type: 'state_sync',
-    initialized,
-    worldObjects: Array.from(worldObjects.entries()).map(([objectID, state]) => ({ objectID, state })),
-    playerCharacters: Array.from(playerCharacters.entries()).map(([playerID, state]) => ({ playerID, state }))
-  });
+  // 초기 상태는 hello 로 청크 수신 가능 여부를 확인한 뒤 전송.
+  // hello 는 접속 직후 첫 메시지이므로, 다른 메시지가 먼저 오면 구버전 클라이언트로 보고 바로 전송
+  clients.get(ws).syncTimer = setTimeout(() => beginStateSync(ws), HELLO_TIMEOUT_MS);
 
-  ws.on('message', (raw) => {
+  ws.on('message', (raw, isBinary) => {
     let msg;
-    try { msg = JSON.parse(raw.toString()); }
-    catch (err) { console.warn("JSON 파싱 실패:", err.message); return; }
+    if (isBinary) {
+      const meta = clients.get(ws) || {};
+      msg = protocol.decode(raw, meta.baselines, handles);
+      if (!msg) { console.warn("바이너리 프레임 디코딩 실패"); return; }
+      if (msg.dropped) return; // baseline 불일치 → ack 없이 버림 (클라이언트가 키프레임으로 복구)
+    } else {
+      try { msg = JSON.parse(raw.toString()); }
+      catch (err) { console.warn("JSON 파싱 실패:", err.message); return; }
+    }
+
+    const meta = clients.get(ws);
+    if (meta && meta.syncTimer && msg.type !== 'hello') {
+      clearTimeout(meta.syncTimer);
+      beginStateSync(ws);
+    }
 
     handleMessage(ws, msg);
+
+    // 델타 프레임 수신 확인 → 송신자는 이 seq 를 다음 baseline 으로 사용 (batch 는 ack 도 한 프레임으로)
+    const acks = msg.type === 'batch' && Array.isArray(msg.messages)
+      ? msg.messages.filter(m => m && m.ack).map(m => m.ack)
+      : (msg.ack ? [msg.ack] : []);
+    if (acks.length > 0) sendBinary(ws, protocol.encodeAck(acks));
   });
 
   ws.on('close', () => {
     const meta = clients.get(ws) || {};
     const playerID = meta.playerID;
 
+    clearTimeout(meta.syncTimer);
     clients.delete(ws);
     console.log(`클라이언트 연결 종료: connectionId=${connectionId}`);
+    releaseObjectsOwnedBy(ws);
     if (playerID && playerCharacters.has(playerID)) {
       playerCharacters.delete(playerID);
 
       broadcast({
         type: 'render_update',
         action: 'remove_character',
-        playerID
+        playerID,
+        h: handles.handleOf(playerID)
       });
+
+      const released = handles.release(playerID);
+      if (released !== undefined) broadcast({ type: 'handle_map', released: [released] });
     }
   });
 });
@@ -56,24 +120,76 @@ wss.on('connection', (ws) => {
 function handleMessage(ws, msg) {
   switch (msg.type) {
 
+    case 'batch': {
+      // 클라이언트가 한 틱 동안 만든 메시지 묶음 (중첩 batch 는 무시)
+      const messages = Array.isArray(msg.messages) ? msg.messages : [];
+      messages.forEach(m => {
+        if (m && typeof m === 'object' && m.type !== 'batch') handleMessage(ws, m);
+      });
+      break;
+    }
+
+    case 'hello': {
+      // 와이어 포맷 협상: 같은 버전일 때만 바이너리, 아니면 JSON 유지
+      const meta = clients.get(ws) || {};
+      meta.binary = msg.binary === protocol.BINARY_VERSION;
+      clients.set(ws, meta);
+
+      // 양자화 파라미터는 서버 전체에서 하나 (첫 클라이언트의 레벨 경계 채택)
+      const quant = meta.binary ? protocol.negotiateQuantizer(msg.quant).toJSON() : undefined;
+      send(ws, { type: 'hello_ack', binary: meta.binary ? protocol.BINARY_VERSION : 0, quant });
+
+      meta.stateChunks = msg.stateChunks === true;
+      if (meta.syncTimer) {
+        clearTimeout(meta.syncTimer);
+        meta.syncTimer = null;
+        beginStateSync(ws);
+      }
+      break;
+    }
+
+    case 'ping': {
+      // 틱을 기다리지 않고 바로 응답 (대기 시간이 RTT 에 섞이지 않도록)
+      send(ws, { type: 'pong', t0: msg.t0, ts: serverNowMs() });
+      break;
+    }
+
+    case 'state_chunk_ack': {
+      const meta = clients.get(ws);
+      const sync = meta && meta.sync;
+      if (!sync || msg.syncId !== sync.id) break; // 이전 동기화의 늦은 ack
+
+      sync.acked = Math.max(sync.acked, (Number(msg.chunk) || 0) + 1);
+      if (sync.acked >= sync.chunkCount) {
+        meta.sync = null;
+        break;
+      }
+      pumpStateSync(ws);
+      break;
+    }
+
     case 'register_batch': {
       if (initialized) return;
 
       const objects = Array.isArray(msg.objects) ? msg.objects : [];
+      const assigned = [];
       objects.forEach(o => {
         if (!o.objectID) return;
         worldObjects.set(o.objectID, {
           position: o.position,
           rotation: o.rotation
         });
+        const { handle, isNew } = handles.allocate(o.objectID);
+        if (isNew) assigned.push({ h: handle, id: o.objectID });
       });
 
       initialized = true;
 
+      if (assigned.length > 0) broadcast({ type: 'handle_map', entries: assigned });
       broadcast({
         type: 'render_update',
         action: 'add_batch',
-        objects: Array.from(worldObjects.entries()).map(([objectID, state]) => ({ objectID, ...state }))
+        objects: Array.from(worldObjects.entries()).map(([objectID, state]) => ({ objectID, h: handles.handleOf(objectID), ...state }))
       });
 
       break;
@@ -87,7 +203,8 @@ function handleMessage(ws, msg) {
       meta.playerID = playerID;
       clients.set(ws, meta);
 
-      send(ws, { type: 'id', id: playerID });
+      const h = registerHandle(playerID);
+      send(ws, { type: 'id', id: playerID, h });
 
       const initialState = {
         position: msg.position,
@@ -107,6 +224,7 @@ function handleMessage(ws, msg) {
         type: 'render_update',
         action: 'add_character',
         playerID,
+        h,
         state: initialState
       });
 
@@ -120,6 +238,8 @@ function handleMessage(ws, msg) {
 
             if (!worldObjects.has(id)) {
                 worldObjects.set(id, state);
+                // 보낸 클라이언트도 이 핸들을 받아야 이후 바이너리로 전송 가능
+                const h = registerHandle(id);
 
                 console.log(`[WORLD OBJECT ADDED] id=${id}, pos=(${state.position.x},${state.position.y},${state.position.z}), rot=(${state.rotation.pitch},${state.rotation.yaw},${state.rotation.roll})`);
 
@@ -128,27 +248,26 @@ function handleMessage(ws, msg) {
                     type: 'render_update',
                     action: 'add_object',
                     id,
+                    h,
                     state,
                     isObject: true
                 });
             } 
             // 이미 등록된 오브젝트 위치/회전 갱신
             else {
+                // 소유자가 아닌 클라이언트의 transform 은 버림 (소유자의 상태가 update_batch 로 덮어씀)
+                if (!claimObject(ws, id, msg.claim === true)) return;
+
                 const obj = worldObjects.get(id);
                 obj.position = state.position;
                 obj.rotation = state.rotation;
+                obj.velocity = vector3(state.velocity);
+                obj.angularVelocity = vector3(state.angularVelocity);
 
                 console.log(`[WORLD OBJECT UPDATED] id=${id}, pos=(${state.position.x},${state.position.y},${state.position.z}), rot=(${state.rotation.pitch},${state.rotation.yaw},${state.rotation.roll})`);
 
-                // (자신 제외)
-                broadcastToOthers(ws, {
-                    type: 'render_update',
-                    action: 'update',
-                    entityType: 'world',
-                    id,
-                    state: obj,
-                    isObject: true
-                });
+                // 다음 틱의 update_batch 로 전송 (보낸 클라이언트는 src 로 자기 변경을 건너뜀)
+                markObjectDirty(ws, id);
             }
             return; // update 처리 완료
         }
@@ -162,15 +281,10 @@ function handleMessage(ws, msg) {
             p.rotation = state.rotation;
             if (state.speed !== undefined) p.speed = state.speed;
             if (state.isFalling !== undefined) p.isFalling = state.isFalling;
+            p.ts = senderTimestamp(state.ts);
             playerCharacters.set(id, p);
 
-            broadcastToOthers(ws, {
-                type: 'render_update',
-                action: 'update',
-                entityType: 'player',
-                id,
-                state: p
-            });
+            dirtyPlayers.add(id);
         }
 
         break;
@@ -178,7 +292,7 @@ function handleMessage(ws, msg) {
 
 
     case 'transform': {
-        const { id, x, y, z, pitch, yaw, roll, speed, isFalling } = msg;
+        const { id, x, y, z, pitch, yaw, roll, speed, isFalling, ts } = msg;
 
         // 플레이어인지 월드 오브젝트인지 체크
         if (playerCharacters.has(id)) {
@@ -187,32 +301,26 @@ function handleMessage(ws, msg) {
             p.rotation = { pitch, yaw, roll };
             if (speed !== undefined) p.speed = speed;
             if (isFalling !== undefined) p.isFalling = isFalling;
+            p.ts = senderTimestamp(ts);
 
             playerCharacters.set(id, p);
 
             // console.log(`[PLAYER TRANSFORM] id=${id}, pos=(${x},${y},${z}), rot=(${pitch},${yaw},${roll}), speed=${p.speed}, isFalling=${p.isFalling}`);
 
-            broadcastToOthers(ws, {
-                type: 'render_update',
-                action: 'transform',
-                playerID: id,
-                state: p
-            });
+            dirtyPlayers.add(id);
         } 
         else if (worldObjects.has(id)) {
+            if (!claimObject(ws, id, msg.claim === true)) break;
+
             const obj = worldObjects.get(id);
             obj.position = { x, y, z };
             obj.rotation = { pitch, yaw, roll };
+            obj.velocity = vector3(msg.velocity);
+            obj.angularVelocity = vector3(msg.angularVelocity);
 
             console.log(`[WORLD OBJECT TRANSFORM] id=${id}, pos=(${x},${y},${z}), rot=(${pitch},${yaw},${roll})`);
 
-            broadcastToOthers(ws, {
-                type: 'render_update',
-                action: 'update',
-                entityType: 'world',
-                id,
-                state: obj
-            });
+            markObjectDirty(ws, id);
         } 
         else {
             console.warn(`[TRANSFORM] Unknown ID received: ${id}`);
@@ -237,17 +345,209 @@ function handleMessage(ws, msg) {
     }
 
     case 'request_state': {
-      send(ws, {
-        type: 'state_sync',
-        initialized,
-        worldObjects: Array.from(worldObjects.entries()).map(([objectID, state]) => ({ objectID, state })),
-        playerCharacters: Array.from(playerCharacters.entries()).map(([playerID, state]) => ({ playerID, state }))
-      });
+      beginStateSync(ws);
       break;
     }
   }
 }
 
+// ws 가 id 의 transform 을 보낼 수 있으면 소유권을 갱신(또는 넘겨받음)하고 true
+function claimObject(ws, id, claim) {
+  const now = serverNowMs();
+  const owner = objectOwners.get(id);
+  if (owner && owner.ws === ws) {
+    owner.until = now + OWNERSHIP_TIMEOUT_MS;
+    return true;
+  }
+  if (owner && owner.until > now && !(claim && now - owner.since >= OWNERSHIP_MIN_HOLD_MS)) return false;
+
+  objectOwners.set(id, { ws, since: now, until: now + OWNERSHIP_TIMEOUT_MS });
+  return true;
+}
+
+function releaseObjectsOwnedBy(ws) {
+  for (const [id, owner] of objectOwners) {
+    if (owner.ws === ws) objectOwners.delete(id);
+  }
+}
+
+function vector3(v) {
+  return { x: Number(v && v.x) || 0, y: Number(v && v.y) || 0, z: Number(v && v.z) || 0 };
+}
+
+function markObjectDirty(ws, id) {
+  const meta = clients.get(ws);
+  const src = meta && meta.playerID ? handles.handleOf(meta.playerID) : undefined;
+  dirtyObjects.set(id, src || 0);
+}
+
+// ---------------------------------------------------------------------------
+// 고정 주기 틱
+// ---------------------------------------------------------------------------
+
+const tickMetrics = { ticks: 0, totalMs: 0, maxMs: 0, maxLateMs: 0, maxDirty: 0, frames: 0, maxBufferedBytes: 0 };
+let nextTickAt = performance.now() + TICK_INTERVAL_MS;
+
+function scheduleTick() {
+  setTimeout(runTick, Math.max(0, nextTickAt - performance.now()));
+}
+
+function runTick() {
+  const start = performance.now();
+  const lateMs = start - nextTickAt;
+  nextTickAt += TICK_INTERVAL_MS;
+  // 크게 밀렸으면 밀린 틱을 몰아서 돌리지 않고 기준 시각을 다시 잡음
+  if (lateMs > TICK_INTERVAL_MS * 4) nextTickAt = start + TICK_INTERVAL_MS;
+
+  const dirtyCount = dirtyPlayers.size + dirtyObjects.size;
+  const { frames, bufferedBytes } = flushDirtyState();
+
+  const elapsed = performance.now() - start;
+  tickMetrics.ticks++;
+  tickMetrics.totalMs += elapsed;
+  tickMetrics.maxMs = Math.max(tickMetrics.maxMs, elapsed);
+  tickMetrics.maxLateMs = Math.max(tickMetrics.maxLateMs, lateMs);
+  tickMetrics.maxDirty = Math.max(tickMetrics.maxDirty, dirtyCount);
+  tickMetrics.frames += frames;
+  tickMetrics.maxBufferedBytes = Math.max(tickMetrics.maxBufferedBytes, bufferedBytes);
+
+  scheduleTick();
+}
+
+// dirty 엔티티의 최신 상태를 update_batch 하나로 묶어 전송. 포맷별 인코딩은 틱당 최대 한 번
+function flushDirtyState() {
+  const result = { frames: 0, bufferedBytes: 0 };
+  if (dirtyPlayers.size === 0 && dirtyObjects.size === 0) return result;
+
+  const players = [];
+  for (const playerID of dirtyPlayers) {
+    const p = playerCharacters.get(playerID);
+    if (!p) continue;
+    // meta(이름)는 add_character / state_sync 로 이미 전달됨. ts 는 송신자가 찍은 시각 그대로
+    players.push({ playerID, h: handles.handleOf(playerID), state: { position: p.position, rotation: p.rotation, speed: p.speed, isFalling: p.isFalling, ts: p.ts } });
+  }
+  const objects = [];
+  for (const [objectID, src] of dirtyObjects) {
+    const obj = worldObjects.get(objectID);
+    if (!obj) continue;
+    // src 는 소유자. 받는 쪽은 velocity / angularVelocity 로 다음 수신까지 외삽
+    objects.push({
+      objectID, h: handles.handleOf(objectID), src,
+      state: { position: obj.position, rotation: obj.rotation, velocity: vector3(obj.velocity), angularVelocity: vector3(obj.angularVelocity) }
+    });
+  }
+  dirtyPlayers.clear();
+  dirtyObjects.clear();
+  if (players.length === 0 && objects.length === 0) return result;
+
+  const payloadFor = makePayloadSelector({ type: 'render_update', action: 'update_batch', serverTime: serverNowMs(), players, objects });
+  wss.clients.forEach(client => {
+    if (client.readyState !== WebSocket.OPEN) return;
+    client.send(payloadFor(client));
+    result.frames++;
+    result.bufferedBytes += client.bufferedAmount; // 아직 소켓으로 못 나간 바이트 (느린 클라이언트 backlog)
+  });
+  return result;
+}
+
+setInterval(() => {
+  if (tickMetrics.ticks === 0) return;
+  console.log(`[TICK] rate=${TICK_RATE_HZ}Hz ticks=${tickMetrics.ticks} avg=${(tickMetrics.totalMs / tickMetrics.ticks).toFixed(3)}ms ` +
+    `max=${tickMetrics.maxMs.toFixed(3)}ms lateMax=${tickMetrics.maxLateMs.toFixed(1)}ms dirtyMax=${tickMetrics.maxDirty} ` +
+    `frames=${tickMetrics.frames} bufferedMax=${tickMetrics.maxBufferedBytes}B`);
+  Object.assign(tickMetrics, { ticks: 0, totalMs: 0, maxMs: 0, maxLateMs: 0, maxDirty: 0, frames: 0, maxBufferedBytes: 0 });
+}, METRICS_INTERVAL_MS);
+
+scheduleTick();
+
+// 새 엔티티면 핸들을 할당하고 모든 클라이언트에 handle_map 으로 한 번만 알림
+function registerHandle(name) {
+  const { handle, isNew } = handles.allocate(name);
+  if (isNew) broadcast({ type: 'handle_map', entries: [{ h: handle, id: name }] });
+  return handle;
+}
+
+function stateSyncMessage() {
+  return {
+    type: 'state_sync',
+    initialized,
+    worldObjects: Array.from(worldObjects.entries()).map(([objectID, state]) => ({ objectID, h: handles.handleOf(objectID), state })),
+    playerCharacters: Array.from(playerCharacters.entries()).map(([playerID, state]) => ({ playerID, h: handles.handleOf(playerID), state }))
+  };
+}
+
+// ---------------------------------------------------------------------------
+// 초기 상태 동기화
+// ---------------------------------------------------------------------------
+
+function beginStateSync(ws) {
+  const meta = clients.get(ws);
+  if (!meta) return;
+  meta.syncTimer = null;
+
+  if (!meta.stateChunks) {
+    // 지금까지 할당된 핸들 전체 → 전체 상태를 한 프레임으로
+    send(ws, { type: 'handle_map', entries: handles.entries() });
+    send(ws, stateSyncMessage());
+    return;
+  }
+
+  // 엔티티 목록만 지금 고정하고, 상태는 청크를 보내는 시점의 최신값으로 직렬화.
+  // 이후 추가된 엔티티는 add_object / add_character 로, 변경은 update_batch 로 전달됨
+  // (청크의 항목마다 h 가 있으므로 handle_map 전체는 보내지 않음)
+  const playerIDs = Array.from(playerCharacters.keys());
+  const objectIDs = Array.from(worldObjects.keys());
+  const total = playerIDs.length + objectIDs.length;
+  nextSyncId = (nextSyncId % 65535) + 1;
+  meta.sync = {
+    id: nextSyncId,
+    playerIDs,
+    objectIDs,
+    chunkCount: Math.max(1, Math.ceil(total / STATE_CHUNK_ENTITIES)), // 빈 월드도 완료 알림용 청크 하나
+    sent: 0,
+    acked: 0
+  };
+  pumpStateSync(ws);
+}
+
+function pumpStateSync(ws) {
+  const meta = clients.get(ws);
+  const sync = meta && meta.sync;
+  if (!sync) return;
+
+  while (sync.sent < sync.chunkCount && sync.sent - sync.acked < STATE_CHUNK_WINDOW) {
+    sendBinary(ws, protocol.encodeStateChunk(sync.id, sync.sent, sync.chunkCount, stateChunkMessage(sync, sync.sent)));
+    sync.sent++;
+  }
+}
+
+// 플레이어 먼저, 이어서 월드 오브젝트 순으로 STATE_CHUNK_ENTITIES 개씩
+function stateChunkMessage(sync, chunk) {
+  const begin = chunk * STATE_CHUNK_ENTITIES;
+  const end = begin + STATE_CHUNK_ENTITIES;
+  const numPlayers = sync.playerIDs.length;
+
+  const players = [];
+  for (const playerID of sync.playerIDs.slice(Math.min(begin, numPlayers), Math.min(end, numPlayers))) {
+    const state = playerCharacters.get(playerID);
+    if (state) players.push({ playerID, h: handles.handleOf(playerID), state });
+  }
+  const objects = [];
+  for (const objectID of sync.objectIDs.slice(Math.max(0, begin - numPlayers), Math.max(0, end - numPlayers))) {
+    const state = worldObjects.get(objectID);
+    if (state) objects.push({ objectID, h: handles.handleOf(objectID), state });
+  }
+  return { type: 'state_sync', initialized, worldObjects: objects, playerCharacters: players };
+}
+
+function sendBinary(ws, buf) {
+  try {
+    if (ws.readyState === WebSocket.OPEN) {
+      ws.send(buf);
+    }
+  } catch {}
+}
+
 function send(ws, obj) {
   try {
     if (ws.readyState === WebSocket.OPEN) {
@@ -256,19 +556,36 @@ function send(ws, obj) {
   } catch {}
 }
 
+// 클라이언트가 협상한 포맷에 맞는 페이로드 선택 (JSON / 바이너리 모두 최대 한 번만 인코딩)
+function makePayloadSelector(obj) {
+  let json;
+  let binary;
+  return (client) => {
+    const meta = clients.get(client);
+    if (meta && meta.binary) {
+      if (binary === undefined) binary = protocol.encode(obj);
+      if (binary) return binary;
+    }
+    if (json === undefined) json = JSON.stringify(obj);
+    return json;
+  };
+}
+
 function broadcast(obj) {
-  const data = JSON.stringify(obj);
+  const payloadFor = makePayloadSelector(obj);
   wss.clients.forEach(client => {
     if (client.readyState === WebSocket.OPEN) {
+      const data = payloadFor(client);
       setImmediate(() => client.send(data));
     }
   });
 }
 
 function broadcastToOthers(sender, obj) {
-    const data = JSON.stringify(obj);
+    const payloadFor = makePayloadSelector(obj);
     wss.clients.forEach(client => {
         if (client !== sender && client.readyState === WebSocket.OPEN) {
+            const data = payloadFor(client);
             setImmediate(() => client.send(data));
         }
     });